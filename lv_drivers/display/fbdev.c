@@ -13,6 +13,7 @@
 #include <unistd.h>
 #include <stddef.h>
 #include <stdio.h>
+#include <string.h>
 #include <fcntl.h>
 #include <sys/mman.h>
 #include <sys/ioctl.h>
@@ -37,6 +38,8 @@
 #define DIV_ROUND_UP(n, d) (((n) + (d) - 1) / (d))
 #endif
 
+#define FBDEV_PAGES 2
+
 /**********************
  *      TYPEDEFS
  **********************/
@@ -61,6 +64,10 @@ struct bsd_fb_fix_info{
 /**********************
  *  STATIC PROTOTYPES
  **********************/
+#if !USE_BSD_FBDEV
+static void pages_init(void);
+static void pages_sync(void);
+#endif
 
 /**********************
  *  STATIC VARIABLES
@@ -76,6 +83,14 @@ static char *fbp = 0;
 static long int screensize = 0;
 static int fbfd = 0;
 
+/*Page flipping, back page is drawn while the other one is shown*/
+static uint8_t pages = 1;
+static uint8_t back_page = 0;
+static bool vsync = false;
+static lv_area_t last_damage[FBDEV_PAGES * 8];
+static uint16_t last_damage_count = 0;
+static bool synced = true;
+
 /**********************
  *      MACROS
  **********************/
@@ -159,10 +174,20 @@ void fbdev_init(void)
 
     LV_LOG_INFO("The framebuffer device was mapped to memory successfully");
 
+#if !USE_BSD_FBDEV
+    pages_init();
+#endif
+
 }
 
 void fbdev_exit(void)
 {
+#if !USE_BSD_FBDEV
+    if(pages > 1 && vinfo.yoffset != 0) {
+        vinfo.yoffset = 0;
+        ioctl(fbfd, FBIOPAN_DISPLAY, &vinfo);
+    }
+#endif
     munmap(fbp, screensize);
     close(fbfd);
 }
@@ -269,8 +294,175 @@ void fbdev_set_offset(uint32_t xoffset, uint32_t yoffset) {
     vinfo.yoffset = yoffset;
 }
 
+uint32_t * fbdev_get_page(uint32_t *stride) {
+    if(fbp == NULL || (intptr_t)fbp == -1 || vinfo.bits_per_pixel != 32) {
+        return NULL;
+    }
+
+    *stride = finfo.line_length / 4;
+
+    if(pages > 1) {
+#if !USE_BSD_FBDEV
+        /*First flush of the frame*/
+        if(!synced) {
+            pages_sync();
+            synced = true;
+        }
+#endif
+        return (uint32_t *)fbp + vinfo.xoffset + back_page * vinfo.yres * *stride;
+    }
+
+    return (uint32_t *)fbp + vinfo.xoffset + vinfo.yoffset * *stride;
+}
+
+void fbdev_present(const lv_area_t * damage, uint16_t count)
+{
+#if !USE_BSD_FBDEV
+    if(pages < 2) {
+        return;
+    }
+
+    if(!synced) {
+        pages_sync();
+        synced = true;
+    }
+
+    vinfo.yoffset = back_page * vinfo.yres;
+
+    if(ioctl(fbfd, FBIOPAN_DISPLAY, &vinfo) != 0) {
+        perror("ioctl(FBIOPAN_DISPLAY)");
+
+        /*Keep drawing into the shown page from now, it gets the complete frame*/
+        uint8_t front = (back_page + pages - 1) % pages;
+        size_t page_size = finfo.line_length * vinfo.yres;
+
+        memcpy(fbp + front * page_size, fbp + back_page * page_size, page_size);
+
+        pages = 1;
+        vinfo.yoffset = front * vinfo.yres;
+        return;
+    }
+
+#ifdef FBIO_WAITFORVSYNC
+    if(vsync) {
+        uint32_t crtc = 0;
+
+        if(ioctl(fbfd, FBIO_WAITFORVSYNC, &crtc) != 0) {
+            vsync = false;
+        }
+    }
+#endif
+
+    back_page = (back_page + 1) % pages;
+
+    /*Damage of this frame is missing in the new back page*/
+    if(count > sizeof(last_damage) / sizeof(last_damage[0])) {
+        last_damage[0] = damage[0];
+
+        for(uint16_t i = 1; i < count; i++) {
+            _lv_area_join(&last_damage[0], &last_damage[0], &damage[i]);
+        }
+        last_damage_count = 1;
+    } else {
+        memcpy(last_damage, damage, count * sizeof(lv_area_t));
+        last_damage_count = count;
+    }
+    synced = false;
+#else
+    LV_UNUSED(damage);
+    LV_UNUSED(count);
+#endif
+}
+
 /**********************
  *   STATIC FUNCTIONS
  **********************/
 
+#if !USE_BSD_FBDEV
+/**
+ * Two pages in virtual resolution, panning is checked once
+ */
+static void pages_init(void)
+{
+    if(vinfo.bits_per_pixel != 32) {
+        return;
+    }
+
+    if(vinfo.yres_virtual < vinfo.yres * FBDEV_PAGES) {
+        struct fb_var_screeninfo v = vinfo;
+        unsigned long smem_start = finfo.smem_start;
+
+        v.yres_virtual = vinfo.yres * FBDEV_PAGES;
+
+        if(ioctl(fbfd, FBIOPUT_VSCREENINFO, &v) != 0 ||
+                ioctl(fbfd, FBIOGET_VSCREENINFO, &vinfo) != 0 ||
+                ioctl(fbfd, FBIOGET_FSCREENINFO, &finfo) != 0) {
+            LV_LOG_WARN("Can't set virtual resolution, no page flipping");
+            return;
+        }
+
+        /*Driver could reallocate the memory*/
+        if(finfo.smem_start != smem_start || (long int)finfo.smem_len != screensize) {
+            munmap(fbp, screensize);
+
+            screensize = finfo.smem_len;
+            fbp = (char *)mmap(0, screensize, PROT_READ | PROT_WRITE, MAP_SHARED, fbfd, 0);
+
+            if((intptr_t)fbp == -1) {
+                perror("Error: failed to map framebuffer device to memory");
+                fbp = NULL;
+                return;
+            }
+        }
+    }
+
+    if(vinfo.yres_virtual < vinfo.yres * FBDEV_PAGES ||
+            (long int)finfo.line_length * vinfo.yres * FBDEV_PAGES > screensize) {
+        LV_LOG_WARN("Framebuffer is too small, no page flipping");
+        return;
+    }
+
+    vinfo.yoffset = 0;
+
+    if(ioctl(fbfd, FBIOPAN_DISPLAY, &vinfo) != 0) {
+        LV_LOG_WARN("Framebuffer can't pan, no page flipping");
+        return;
+    }
+
+#ifdef FBIO_WAITFORVSYNC
+    uint32_t crtc = 0;
+
+    vsync = ioctl(fbfd, FBIO_WAITFORVSYNC, &crtc) == 0;
+#endif
+
+    /*Back page starts as a copy of the shown one*/
+    memcpy(fbp + finfo.line_length * vinfo.yres, fbp, finfo.line_length * vinfo.yres);
+
+    pages = FBDEV_PAGES;
+    back_page = 1;
+
+    LV_LOG_INFO("Page flipping, vsync %s", vsync ? "on" : "off");
+}
+
+/**
+ * Copy areas of the previous frame from the shown page to the back page,
+ * before this frame is drawn there
+ */
+static void pages_sync(void)
+{
+    uint32_t stride = finfo.line_length / 4;
+    uint32_t * front = (uint32_t *)fbp + vinfo.xoffset + ((back_page + pages - 1) % pages) * vinfo.yres * stride;
+    uint32_t * back = (uint32_t *)fbp + vinfo.xoffset + back_page * vinfo.yres * stride;
+
+    for(uint16_t i = 0; i < last_damage_count; i++) {
+        const lv_area_t * a = &last_damage[i];
+        size_t len = (a->x2 - a->x1 + 1) * 4;
+
+        for(int32_t y = a->y1; y <= a->y2; y++) {
+            memcpy(&back[y * stride + a->x1], &front[y * stride + a->x1], len);
+        }
+    }
+}
+#endif
+
 #endif
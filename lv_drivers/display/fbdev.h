@@ -50,6 +50,21 @@ void fbdev_get_sizes(uint32_t *width, uint32_t *height, uint32_t *dpi);
  * @param yoffset vertical offset
  */
 void fbdev_set_offset(uint32_t xoffset, uint32_t yoffset);
+/**
+ * Direct access to the mapped framebuffer. With page flipping it is the back
+ * page, which gets areas changed in the previous frame on the first call.
+ * @param stride line length in pixels
+ * @return first pixel, or NULL if the framebuffer is not mapped or is not 32 bpp
+ */
+uint32_t * fbdev_get_page(uint32_t *stride);
+/**
+ * Frame is drawn into the back page: pan to it and wait for vsync if
+ * supported, then remember damage for the next frame. Does nothing without
+ * page flipping.
+ * @param damage areas drawn in this frame
+ * @param count number of areas
+ */
+void fbdev_present(const lv_area_t * damage, uint16_t count);
 
 
 /**********************
@@ -0,0 +1,271 @@
+/*
+ *  SPDX-License-Identifier: LGPL-2.1-or-later
+ *
+ *  Xiegu X6100 LVGL GUI
+ *
+ *  Copyright (c) 2024 Georgy Dyuldin aka R2RFE
+ */
+
+#include "assets.h"
+
+#include <dirent.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#define ASSETS_MAX      64
+#define NAME_LEN        32
+
+/* Archive: header, index and image data, see tools/pack_images.py */
+
+#define ARCHIVE_MAGIC   0x50413658  /* "X6AP" */
+#define ARCHIVE_VERSION 1
+
+typedef struct {
+    uint32_t    magic;
+    uint32_t    version;
+    uint32_t    count;
+    uint32_t    reserved;
+} archive_header_t;
+
+typedef struct {
+    char        name[NAME_LEN];
+    uint32_t    header;             /* lv_img_header_t as in .bin file */
+    uint32_t    offset;             /* From archive start, aligned */
+    uint32_t    size;
+    uint32_t    reserved;
+} archive_entry_t;
+
+typedef struct {
+    char            name[NAME_LEN];
+    lv_img_dsc_t    dsc;
+    bool            loaded;
+} image_t;
+
+static image_t          images[ASSETS_MAX];
+static uint16_t         images_count = 0;
+
+static uint8_t          *archive = NULL;
+static size_t           archive_size = 0;
+
+static assets_stats_t   stats;
+
+static bool archive_map(bool preload) {
+    int fd = open(ASSETS_ARCHIVE, O_RDONLY);
+
+    if (fd < 0) {
+        return false;
+    }
+
+    struct stat st;
+
+    if (fstat(fd, &st) < 0 || (size_t) st.st_size < sizeof(archive_header_t)) {
+        close(fd);
+        return false;
+    }
+
+    void *p = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE | (preload ? MAP_POPULATE : 0), fd, 0);
+
+    close(fd);
+
+    if (p == MAP_FAILED) {
+        LV_LOG_ERROR("Can't map %s", ASSETS_ARCHIVE);
+        return false;
+    }
+
+    const archive_header_t *header = p;
+
+    if (header->magic != ARCHIVE_MAGIC || header->version != ARCHIVE_VERSION ||
+        header->count > ASSETS_MAX ||
+        sizeof(archive_header_t) + header->count * sizeof(archive_entry_t) > (size_t) st.st_size)
+    {
+        LV_LOG_ERROR("Wrong archive %s", ASSETS_ARCHIVE);
+        munmap(p, st.st_size);
+        return false;
+    }
+
+    archive = p;
+    archive_size = st.st_size;
+    stats.mapped_bytes = archive_size;
+
+    /* Index only, images are registered on lookup */
+
+    const archive_entry_t *entry = (const archive_entry_t *) (header + 1);
+
+    for (uint32_t i = 0; i < header->count; i++, entry++) {
+        if ((uint64_t) entry->offset + entry->size > archive_size || entry->offset % 4) {
+            LV_LOG_ERROR("Wrong image %.*s in archive", NAME_LEN, entry->name);
+            continue;
+        }
+
+        image_t *img = &images[images_count++];
+
+        strncpy(img->name, entry->name, NAME_LEN - 1);
+        memcpy(&img->dsc.header, &entry->header, sizeof(lv_img_header_t));
+        img->dsc.data_size = entry->size;
+        img->dsc.data = archive + entry->offset;
+    }
+
+    return true;
+}
+
+/**
+ * LVGL .bin file: lv_img_header_t and pixels
+ */
+static bool file_load(image_t *img) {
+    char    path[sizeof(ASSETS_IMAGES) + NAME_LEN + 4];
+
+    snprintf(path, sizeof(path), "%s%s.bin", ASSETS_IMAGES, img->name);
+
+    FILE *f = fopen(path, "rb");
+
+    if (!f) {
+        return false;
+    }
+
+    uint32_t    header;
+    long        size;
+    uint8_t     *data = NULL;
+
+    if (fread(&header, sizeof(header), 1, f) != 1 || fseek(f, 0, SEEK_END) < 0 ||
+        (size = ftell(f) - sizeof(header)) <= 0 || fseek(f, sizeof(header), SEEK_SET) < 0)
+    {
+        goto fail;
+    }
+
+    data = malloc(size);
+
+    if (!data || fread(data, size, 1, f) != 1) {
+        goto fail;
+    }
+
+    fclose(f);
+
+    memcpy(&img->dsc.header, &header, sizeof(lv_img_header_t));
+    img->dsc.data_size = size;
+    img->dsc.data = data;
+    stats.heap_bytes += size;
+
+    return true;
+
+fail:
+    LV_LOG_ERROR("Can't load %s", path);
+    free(data);
+    fclose(f);
+    return false;
+}
+
+static image_t * find(const char *name) {
+    for (uint16_t i = 0; i < images_count; i++) {
+        if (strcmp(images[i].name, name) == 0) {
+            return &images[i];
+        }
+    }
+
+    return NULL;
+}
+
+static image_t * load(const char *name) {
+    image_t *img = find(name);
+
+    if (img) {
+        /* Archive index, data is already mapped */
+        img->loaded = true;
+        stats.images++;
+        return img;
+    }
+
+    if (archive || images_count >= ASSETS_MAX || strlen(name) >= NAME_LEN) {
+        return NULL;
+    }
+
+    img = &images[images_count];
+
+    memset(img, 0, sizeof(*img));
+    strcpy(img->name, name);
+
+    if (!file_load(img)) {
+        return NULL;
+    }
+
+    images_count++;
+    img->loaded = true;
+    stats.images++;
+
+    return img;
+}
+
+static void dir_preload() {
+    DIR *dir = opendir(ASSETS_IMAGES);
+
+    if (!dir) {
+        LV_LOG_ERROR("Can't open %s", ASSETS_IMAGES);
+        return;
+    }
+
+    struct dirent *entry;
+
+    while ((entry = readdir(dir)) != NULL) {
+        char    name[NAME_LEN];
+        size_t  len = strlen(entry->d_name);
+
+        if (len <= 4 || len - 4 >= NAME_LEN || strcmp(entry->d_name + len - 4, ".bin") != 0) {
+            continue;
+        }
+
+        memcpy(name, entry->d_name, len - 4);
+        name[len - 4] = '\0';
+
+        if (!find(name)) {
+            load(name);
+        }
+    }
+
+    closedir(dir);
+}
+
+void assets_init(bool preload) {
+    memset(&stats, 0, sizeof(stats));
+
+    if (archive_map(preload)) {
+        if (preload) {
+            for (uint16_t i = 0; i < images_count; i++) {
+                images[i].loaded = true;
+            }
+            stats.images = images_count;
+        }
+    } else if (preload) {
+        dir_preload();
+    }
+
+    LV_LOG_USER("%s: %u images, %zu bytes mapped, %zu bytes in heap",
+                archive ? "Archive" : "Images", stats.images, stats.mapped_bytes, stats.heap_bytes);
+}
+
+const lv_img_dsc_t * assets_img(const char *name) {
+    image_t *img = find(name);
+
+    if (img && img->loaded) {
+        stats.hits++;
+        return &img->dsc;
+    }
+
+    img = load(name);
+
+    if (!img) {
+        stats.failed++;
+        return NULL;
+    }
+
+    stats.misses++;
+
+    return &img->dsc;
+}
+
+void assets_get_stats(assets_stats_t *s) {
+    *s = stats;
+}
@@ -0,0 +1,49 @@
+/*
+ *  SPDX-License-Identifier: LGPL-2.1-or-later
+ *
+ *  Xiegu X6100 LVGL GUI
+ *
+ *  Copyright (c) 2024 Georgy Dyuldin aka R2RFE
+ */
+
+#pragma once
+
+#include "lvgl/lvgl.h"
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/**
+ * In-memory images for styles and widgets.
+ *
+ * Images come from the packed archive (tools/pack_images.py), which is
+ * mapped to memory, or from separate LVGL .bin files, which are read to
+ * heap. Each image is registered once as lv_img_dsc_t, so LVGL draws it
+ * from memory instead of opening the file on each redraw.
+ */
+
+#define ASSETS_DIR      "/usr/share/x6100/"
+#define ASSETS_ARCHIVE  ASSETS_DIR "images.pack"
+#define ASSETS_IMAGES   ASSETS_DIR "images/"
+
+typedef struct {
+    uint16_t    images;         /* Registered */
+    uint32_t    hits;
+    uint32_t    misses;         /* Image was loaded on lookup */
+    uint32_t    failed;         /* Unknown or broken images */
+    size_t      mapped_bytes;   /* Archive */
+    size_t      heap_bytes;     /* Loaded from files */
+} assets_stats_t;
+
+/**
+ * Map archive if exists, otherwise images are read from directory. With
+ * preload all images are registered now, otherwise on first lookup
+ */
+void assets_init(bool preload);
+
+/**
+ * Image by name without extension ("btn_dark"), NULL if there is no such
+ */
+const lv_img_dsc_t * assets_img(const char *name);
+
+void assets_get_stats(assets_stats_t *stats);
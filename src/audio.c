@@ -24,6 +24,7 @@
 #include "dsp.h"
 #include "params/params.h"
 #include "dialog_recorder.h"
+#include "simd/simd.h"
 
 #define AUDIO_RATE_MS   100
 
@@ -180,41 +181,11 @@ void audio_play_wait() {
 }
 
 void audio_gain_db(int16_t *buf, size_t samples, float gain, int16_t *out) {
-    float scale = exp10f(gain / 20.0f);
-
-    for (uint16_t i = 0; i < samples; i++) {
-        int32_t x = buf[i] * scale;
-
-        if (x > 32767) {
-            x = 32767;
-        }
-
-        if (x < -32767) {
-            x = -32767;
-        }
-
-        out[i] = x;
-    }
+    simd_gain_s16(buf, samples, exp10f(gain / 20.0f), out);
 }
 
 void audio_gain_db_transition(int16_t *buf, size_t samples, float gain1, float gain2, int16_t *out) {
-    float scale1 = exp10f(gain1 / 20.0f);
-    float scale2 = exp10f(gain2 / 20.0f);
-    float scale;
-    for (uint16_t i = 0; i < samples; i++) {
-        scale = scale1 + i * (scale2 - scale1) / samples;
-        int32_t x = buf[i] * scale;
-
-        if (x > 32767) {
-            x = 32767;
-        }
-
-        if (x < -32767) {
-            x = -32767;
-        }
-
-        out[i] = x;
-    }
+    simd_gain_ramp_s16(buf, samples, exp10f(gain1 / 20.0f), exp10f(gain2 / 20.0f), out);
 }
 
 void audio_play_en(bool on) {
@@ -0,0 +1,175 @@
+/*
+ *  SPDX-License-Identifier: LGPL-2.1-or-later
+ *
+ *  Xiegu X6100 LVGL GUI
+ *
+ *  Copyright (c) 2024 Georgy Dyuldin aka R2RFE
+ */
+
+#include "audio_bus.h"
+
+#include <stdlib.h>
+#include <pthread.h>
+#include <semaphore.h>
+#include <stdatomic.h>
+
+#include "spsc_ring.h"
+
+typedef struct {
+    audio_block_t   block;      /* First, slot is found by block pointer */
+    atomic_int      refs;       /* 0 - free */
+} slot_t;
+
+struct audio_bus_sub_s {
+    audio_bus_cb_t  cb;
+    void            *user;
+    atomic_bool     enabled;
+
+    spsc_ring_t     queue;      /* Worker only, pointers to slots */
+    sem_t           sem;
+    atomic_uint     drops;
+};
+
+static slot_t                   pool[AUDIO_BUS_BLOCKS];
+static uint8_t                  pool_pos = 0;
+
+static atomic_uint              pool_drops = 0;
+
+static struct audio_bus_sub_s   subs[AUDIO_BUS_SUBS];
+static atomic_uint              subs_count = 0;
+
+static void release(slot_t *slot) {
+    atomic_fetch_sub_explicit(&slot->refs, 1, memory_order_release);
+}
+
+static void * worker_thread(void *arg) {
+    audio_bus_sub_t sub = (audio_bus_sub_t) arg;
+
+    while (true) {
+        sem_wait(&sub->sem);
+
+        slot_t **item = spsc_ring_read_begin(sub->queue);
+
+        if (item) {
+            slot_t *slot = *item;
+
+            spsc_ring_read_commit(sub->queue);
+            sub->cb(&slot->block, sub->user);
+            release(slot);
+        }
+    }
+
+    return NULL;
+}
+
+void audio_bus_init() {
+    for (uint8_t i = 0; i < AUDIO_BUS_BLOCKS; i++) {
+        pool[i].block.n = 0;
+        pool[i].block.raw = malloc(AUDIO_BUS_BLOCK * sizeof(int16_t));
+        pool[i].block.analytic = malloc(AUDIO_BUS_BLOCK * sizeof(float complex));
+        atomic_init(&pool[i].refs, 0);
+    }
+}
+
+audio_bus_sub_t audio_bus_subscribe(audio_bus_cb_t cb, void *user, uint16_t queue) {
+    unsigned int n = atomic_load(&subs_count);
+
+    if (n >= AUDIO_BUS_SUBS) {
+        return NULL;
+    }
+
+    audio_bus_sub_t sub = &subs[n];
+
+    sub->cb = cb;
+    sub->user = user;
+    sub->queue = NULL;
+    atomic_init(&sub->enabled, true);
+    atomic_init(&sub->drops, 0);
+
+    if (queue) {
+        pthread_t   thread;
+        uint16_t    n = 1;
+
+        /* Ring size is power of 2, keep it below the pool for other subscribers */
+        while (n < queue) {
+            n <<= 1;
+        }
+
+        if (n >= AUDIO_BUS_BLOCKS) {
+            n = AUDIO_BUS_BLOCKS / 2;
+        }
+
+        sub->queue = spsc_ring_create(sizeof(slot_t *), n);
+        sem_init(&sub->sem, 0, 0);
+
+        pthread_create(&thread, NULL, worker_thread, sub);
+        pthread_detach(thread);
+    }
+
+    atomic_store_explicit(&subs_count, n + 1, memory_order_release);
+
+    return sub;
+}
+
+void audio_bus_set_enabled(audio_bus_sub_t sub, bool on) {
+    if (sub) {
+        atomic_store(&sub->enabled, on);
+    }
+}
+
+audio_block_t * audio_bus_acquire() {
+    for (uint8_t i = 0; i < AUDIO_BUS_BLOCKS; i++) {
+        slot_t *slot = &pool[pool_pos];
+
+        pool_pos = (pool_pos + 1) % AUDIO_BUS_BLOCKS;
+
+        /* Only producer takes free slots, so plain store is enough */
+        if (atomic_load_explicit(&slot->refs, memory_order_acquire) == 0) {
+            atomic_store_explicit(&slot->refs, 1, memory_order_relaxed);
+            return &slot->block;
+        }
+    }
+
+    atomic_fetch_add(&pool_drops, 1);
+
+    return NULL;
+}
+
+void audio_bus_publish(audio_block_t *block) {
+    slot_t          *slot = (slot_t *) block;
+    unsigned int    n = atomic_load_explicit(&subs_count, memory_order_acquire);
+
+    /* Workers first, they run while synchronous subscribers are called */
+    for (unsigned int i = 0; i < n; i++) {
+        audio_bus_sub_t sub = &subs[i];
+
+        if (!sub->queue || !atomic_load(&sub->enabled)) {
+            continue;
+        }
+
+        slot_t **item = spsc_ring_write_begin(sub->queue);
+
+        if (item) {
+            atomic_fetch_add_explicit(&slot->refs, 1, memory_order_relaxed);
+            *item = slot;
+            spsc_ring_write_commit(sub->queue);
+            sem_post(&sub->sem);
+        } else {
+            atomic_fetch_add(&sub->drops, 1);
+        }
+    }
+
+    for (unsigned int i = 0; i < n; i++) {
+        audio_bus_sub_t sub = &subs[i];
+
+        if (!sub->queue && atomic_load(&sub->enabled)) {
+            sub->cb(block, sub->user);
+        }
+    }
+
+    release(slot);
+}
+
+uint32_t audio_bus_drops(audio_bus_sub_t sub) {
+    return sub ? atomic_load(&sub->drops) + atomic_load(&pool_drops) : 0;
+}
@@ -0,0 +1,68 @@
+/*
+ *  SPDX-License-Identifier: LGPL-2.1-or-later
+ *
+ *  Xiegu X6100 LVGL GUI
+ *
+ *  Copyright (c) 2024 Georgy Dyuldin aka R2RFE
+ */
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <complex.h>
+
+#define AUDIO_BUS_BLOCK     1024    /* Max samples in block */
+#define AUDIO_BUS_BLOCKS    128     /* Pool size, ~3 s at 44.1 kHz */
+#define AUDIO_BUS_SUBS      8
+
+/**
+ * Captured audio fan-out.
+ *
+ * Blocks are taken from a preallocated pool and reference counted: every
+ * subscriber gets the same block, so there are no copies. Subscriber is
+ * called on the capture thread, or on its own worker thread when created
+ * with queue length. Worker loses blocks when its queue is full, capture
+ * never waits.
+ *
+ * Block content is read only for subscribers.
+ */
+typedef struct {
+    size_t          n;
+    int16_t         *raw;       /* Samples as captured */
+    float complex   *analytic;  /* Analytic signal, amplitude 1.0 is full scale */
+} audio_block_t;
+
+/**
+ * Block is valid until callback returns
+ */
+typedef void (*audio_bus_cb_t)(const audio_block_t *block, void *user);
+
+typedef struct audio_bus_sub_s * audio_bus_sub_t;
+
+void audio_bus_init();
+
+/**
+ * Subscribe before audio is started, subscription is never removed.
+ * Starts enabled. With queue > 0 callback runs on a worker thread. Queue
+ * is rounded up to power of 2 and limited to half of the pool
+ */
+audio_bus_sub_t audio_bus_subscribe(audio_bus_cb_t cb, void *user, uint16_t queue);
+
+/**
+ * Disabled subscriber does not get blocks and does not hold the pool
+ */
+void audio_bus_set_enabled(audio_bus_sub_t sub, bool on);
+
+/**
+ * Producer side, capture thread only. Return NULL if pool is exhausted.
+ * Fill block (n <= AUDIO_BUS_BLOCK) and publish it, bus owns it after that
+ */
+audio_block_t * audio_bus_acquire();
+void audio_bus_publish(audio_block_t *block);
+
+/**
+ * Blocks lost by subscriber: full worker queue or exhausted pool
+ */
+uint32_t audio_bus_drops(audio_bus_sub_t sub);
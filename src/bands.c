@@ -18,6 +18,7 @@
 #include "voice.h"
 #include "dsp.h"
 #include "pubsub_ids.h"
+#include "static_layer.h"
 
 #include "lvgl/lvgl.h"
 
@@ -45,6 +46,7 @@ void bands_activate(band_t *band, uint64_t *freq) {
     lv_msg_send(MSG_SPECTRUM_ZOOM_CHANGED, &zoom_factor);
     spectrum_min_max_reset();
     waterfall_min_max_reset();
+    static_layer_invalidate_all();
 }
 
 void bands_change(bool up) {
@@ -157,7 +157,7 @@ static button_item_t    buttons[] = {
     { .label_type = LABEL_FN,   .label_fn = agc_hang_label_getter,  .press = button_mfk_update_cb,  .hold = button_mfk_hold_cb,     .data = MFK_AGC_HANG },
     { .label_type = LABEL_FN,   .label_fn = agc_knee_label_getter,  .press = button_mfk_update_cb,  .hold = button_mfk_hold_cb,     .data = MFK_AGC_KNEE },
     { .label_type = LABEL_FN,   .label_fn = agc_slope_label_getter, .press = button_mfk_update_cb,  .hold = button_mfk_hold_cb,     .data = MFK_AGC_SLOPE },
-    { .label_type = LABEL_TEXT, .label = "",                        .press = NULL },
+    { .label_type = LABEL_TEXT, .label = "WF\nHistory",             .press = button_mfk_update_cb,  .hold = button_mfk_hold_cb,     .data = MFK_WATERFALL_HISTORY },
 
     { .label_type = LABEL_TEXT, .label = "(MEM 1:2)",         .press = button_next_page_cb,   .hold = button_prev_page_cb,    .next = PAGE_MEM_2, .prev = PAGE_MFK_4, .voice = "Memory|page 1" },
     { .label_type = LABEL_TEXT, .label = "Set 1",             .press = button_mem_load_cb,    .hold = button_mem_save_cb,     .data = 1 },
@@ -307,12 +307,18 @@ static button_item_t    buttons[] = {
 
     /* Recorder */
 
-    { .label_type = LABEL_TEXT, .label = "(REC 1:1)",         .press = NULL },
+    { .label_type = LABEL_TEXT, .label = "(REC 1:2)",         .press = button_next_page_cb,   .next = PAGE_RECORDER_2, .prev = PAGE_RECORDER_2 },
     { .label_type = LABEL_TEXT, .label = "Rec",               .press = dialog_recorder_rec_cb },
     { .label_type = LABEL_TEXT, .label = "Rename",            .press = dialog_recorder_rename_cb },
     { .label_type = LABEL_TEXT, .label = "Delete",            .press = dialog_recorder_delete_cb },
     { .label_type = LABEL_TEXT, .label = "Play",              .press = dialog_recorder_play_cb },
 
+    { .label_type = LABEL_TEXT, .label = "(REC 2:2)",         .press = button_next_page_cb,   .next = PAGE_RECORDER, .prev = PAGE_RECORDER },
+    { .label_type = LABEL_TEXT, .label = "IQ Rec",            .press = dialog_recorder_iq_rec_cb },
+    { .label_type = LABEL_TEXT, .label = "IQ Play",           .press = dialog_recorder_iq_play_cb },
+    { .label_type = LABEL_TEXT, .label = "IQ Play\nFast",     .press = dialog_recorder_iq_play_fast_cb },
+    { .label_type = LABEL_TEXT, .label = "",                  .press = NULL },
+
     /* WIFI */
     { .label_type = LABEL_TEXT, .label = "",                  .press = NULL },
     { .label_type = LABEL_TEXT, .label = "",                  .press = NULL },
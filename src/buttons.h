@@ -48,6 +48,7 @@ typedef enum {
     PAGE_MSG_VOICE_1,
     PAGE_MSG_VOICE_2,
     PAGE_RECORDER,
+    PAGE_RECORDER_2,
     PAGE_WIFI,
 } button_page_t;
 
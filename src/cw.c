@@ -16,6 +16,10 @@
 #include "util.h"
 #include "cw_tune_ui.h"
 #include "pubsub_ids.h"
+#include "dsp/quantile.h"
+#include "audio_bus.h"
+#include "radio.h"
+#include "rtty.h"
 
 #include <math.h>
 #include "lvgl/lvgl.h"
@@ -51,12 +55,13 @@ static float            noise_filtered;
 static float            threshold_pulse;
 static float            threshold_silence;
 static float            rms_db_max;
-static float            rms_db_min;
+static quantile_t       rms_quantile;
 static bool             peak_on = false;
 
 static pthread_mutex_t  cw_mutex = PTHREAD_MUTEX_INITIALIZER;
 
 static void dds_dec_init();
+static void audio_cb(const audio_block_t *block, void *user);
 
 void cw_init() {
     input_cbuf = cbuffercf_create(10000);
@@ -70,11 +75,23 @@ void cw_init() {
     fft_plan = fft_create_plan(FFT, fft_time, fft_freq, LIQUID_FFT_FORWARD, 0);
 
     rms_delay = wdelayf_create(FFT / wrms_delay(wrms));
+    rms_quantile = quantile_create(S_MIN, 0.0f, 0.25f);
 
     peak_filtered = -10.0f;
     noise_filtered = -20.0f;
 
     ready = true;
+
+    audio_bus_subscribe(audio_cb, NULL, 0);
+}
+
+static void audio_cb(const audio_block_t *block, void *user) {
+    x6100_mode_t    mode = radio_current_mode();
+
+    /* Text panel belongs to RTTY while it receives */
+    if ((mode == x6100_mode_cw || mode == x6100_mode_cwr) && rtty_get_state() != RTTY_RX) {
+        cw_put_audio_samples(block->n, block->analytic);
+    }
 }
 
 void cw_notify_change_key_tone() {
@@ -133,11 +150,18 @@ static void update_thresholds() {
     }
     noise = sum_all - sum_signal;
 
+    // Low percentile of RMS since last update, robust to single sample dips
+    float rms_db_noise = 0.0f;
+
+    if (quantile_count(rms_quantile)) {
+        rms_db_noise = quantile_get(rms_quantile, 0.1f);
+    }
+
     if (sum_signal/noise > 1) {
         lpf(&peak_filtered, LV_MAX(noise_filtered + params.cw_decoder_snr, rms_db_max), params.cw_decoder_peak_beta, S_MIN);
         threshold_pulse = 0;
     } else {
-        lpf(&noise_filtered, LV_MIN(-3.0f, rms_db_min), params.cw_decoder_noise_beta, S_MIN);
+        lpf(&noise_filtered, LV_MIN(-3.0f, rms_db_noise), params.cw_decoder_noise_beta, S_MIN);
         peak_filtered -= 0.3f;
         if (noise_filtered + params.cw_decoder_snr > peak_filtered) {
             peak_filtered = noise_filtered + params.cw_decoder_snr;
@@ -148,7 +172,7 @@ static void update_thresholds() {
     float low = noise_filtered + params.cw_decoder_snr;
     threshold_pulse += LV_MAX(low, peak_filtered  - 3.0f);
     threshold_silence = threshold_pulse - params.cw_decoder_snr_gist;
-    rms_db_min = 0.0f;
+    quantile_reset(rms_quantile);
     rms_db_max = S1;
 }
 
@@ -224,7 +248,7 @@ void cw_put_audio_samples(unsigned int n, float complex *samples) {
             wrms_pushcf(wrms, sample);
             if (wrms_ready(wrms)) {
                 rms_db = wrms_get_val(wrms);
-                rms_db_min = LV_MIN(rms_db_min, rms_db);
+                quantile_put(rms_quantile, &rms_db, 1);
                 rms_db_max = LV_MAX(rms_db_max, rms_db);
                 wdelayf_push(rms_delay, rms_db);
                 wdelayf_read(rms_delay, &rms_db);
@@ -45,6 +45,7 @@
 #include <time.h>
 #include <sys/time.h>
 #include <pthread.h>
+#include <stdatomic.h>
 #include <errno.h>
 #include <ctype.h>
 
@@ -176,7 +177,7 @@ static lv_obj_t             *waterfall;
 static uint16_t             waterfall_nfft;
 static spgramcf             waterfall_sg;
 static float                *waterfall_psd;
-static uint8_t              waterfall_fps_ms = (1000 / 5);
+static atomic_ushort        waterfall_fps_ms = (1000 / 5);
 static uint64_t             waterfall_time;
 
 static pthread_mutex_t      audio_mutex = PTHREAD_MUTEX_INITIALIZER;
@@ -1312,3 +1313,10 @@ static void * decode_thread(void *arg) {
 
     return NULL;
 }
+
+/**
+ * Waterfall rate, set by governor
+ */
+void dialog_ft8_set_fps(uint8_t fps) {
+    atomic_store(&waterfall_fps_ms, 1000 / LV_MAX(fps, 1));
+}
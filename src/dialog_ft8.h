@@ -11,3 +11,5 @@
 #include "dialog.h"
 
 extern dialog_t *dialog_ft8;
+
+void dialog_ft8_set_fps(uint8_t fps);
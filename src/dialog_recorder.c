@@ -30,6 +30,8 @@
 #include "textarea_window.h"
 #include "msg.h"
 #include "buttons.h"
+#include "iq_record.h"
+#include "dsp/iqfile.h"
 
 #define BUF_SIZE 1024
 #define LEVEL_HEIGHT 25
@@ -369,6 +371,57 @@ void dialog_recorder_delete_cb(lv_event_t * e) {
     }
 }
 
+void dialog_recorder_iq_rec_cb(lv_event_t * e) {
+    if (iq_record_is_on()) {
+        iq_record_stop();
+        msg_update_text_fmt("IQ recording stopped");
+        load_table();
+    } else if (iq_record_start()) {
+        msg_update_text_fmt("IQ recording started");
+        load_table();
+    } else {
+        msg_update_text_fmt("Problem with create file");
+    }
+}
+
+static void iq_play(bool realtime) {
+    if (iq_replay_is_on()) {
+        iq_replay_stop();
+        msg_update_text_fmt("IQ replay stopped");
+        return;
+    }
+
+    const char *item = get_item();
+
+    if (!item) {
+        return;
+    }
+
+    size_t len = strlen(item);
+    size_t ext_len = strlen(IQFILE_DATA_EXT);
+
+    if (len < ext_len || strcmp(item + len - ext_len, IQFILE_DATA_EXT) != 0) {
+        msg_update_text_fmt("Select " IQFILE_DATA_EXT " file");
+        return;
+    }
+
+    char filename[64];
+
+    snprintf(filename, sizeof(filename), "%s/%s", recorder_path, item);
+
+    if (iq_replay_start(filename, realtime)) {
+        msg_update_text_fmt("IQ replay started");
+    }
+}
+
+void dialog_recorder_iq_play_cb(lv_event_t * e) {
+    iq_play(true);
+}
+
+void dialog_recorder_iq_play_fast_cb(lv_event_t * e) {
+    iq_play(false);
+}
+
 void dialog_recorder_set_on(bool on) {
     if (!dialog.run) {
         return;
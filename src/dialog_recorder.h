@@ -17,6 +17,9 @@ void dialog_recorder_rec_cb(lv_event_t * e);
 void dialog_recorder_play_cb(lv_event_t * e);
 void dialog_recorder_rename_cb(lv_event_t * e);
 void dialog_recorder_delete_cb(lv_event_t * e);
+void dialog_recorder_iq_rec_cb(lv_event_t * e);
+void dialog_recorder_iq_play_cb(lv_event_t * e);
+void dialog_recorder_iq_play_fast_cb(lv_event_t * e);
 
 void dialog_recorder_set_on(bool on);
 void dialog_recorder_set_peak(float val);
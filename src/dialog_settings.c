@@ -19,6 +19,9 @@
 #include "clock.h"
 #include "voice.h"
 #include "audio.h"
+#include "iq_record.h"
+#include "dsp.h"
+#include "governor.h"
 
 #include <sys/time.h>
 #include <time.h>
@@ -91,6 +94,42 @@ static void uint8_dropdown_update_cb(lv_event_t * e) {
     params_uint8_set(var, lv_dropdown_get_selected(obj));
 }
 
+static void iq_pretrigger_update_cb(lv_event_t * e) {
+    lv_obj_t        *obj = lv_event_get_target(e);
+    params_uint8_t  *var = lv_event_get_user_data(e);
+
+    params_uint8_set(var, lv_dropdown_get_selected(obj));
+    iq_record_set_pretrigger(iq_record_pretrigger_seconds(var->x));
+}
+
+static void spectrum_nfft_update_cb(lv_event_t * e) {
+    lv_obj_t        *obj = lv_event_get_target(e);
+    params_uint8_t  *var = lv_event_get_user_data(e);
+
+    params_uint8_set(var, lv_dropdown_get_selected(obj));
+    dsp_set_spectrum_nfft(SPECTRUM_NFFT_MIN << var->x);
+}
+
+static void waterfall_nfft_update_cb(lv_event_t * e) {
+    lv_obj_t        *obj = lv_event_get_target(e);
+    params_uint8_t  *var = lv_event_get_user_data(e);
+
+    params_uint8_set(var, lv_dropdown_get_selected(obj));
+    dsp_set_waterfall_nfft(WATERFALL_NFFT << var->x);
+}
+
+static void governor_policy_update_cb(lv_event_t * e) {
+    lv_obj_t        *obj = lv_event_get_target(e);
+    params_uint8_t  *var = lv_event_get_user_data(e);
+
+    params_uint8_set(var, lv_dropdown_get_selected(obj));
+    governor_set_policy(var->x);
+}
+
+static void governor_readout_update_cb(lv_event_t * e) {
+    governor_set_readout(params.governor_readout.x);
+}
+
 static void theme_update_cb(lv_event_t * e) {
     lv_obj_t        *obj = lv_event_get_target(e);
     params_uint8_t  *var = lv_event_get_user_data(e);
@@ -970,6 +1009,44 @@ static uint8_t make_audio_gain(uint8_t row) {
     return row + 1;
 }
 
+/* S-meter calibration */
+
+static void smeter_cal_update_cb(lv_event_t * e) {
+    lv_obj_t        *obj = lv_event_get_target(e);
+    smeter_cal_t    cal = (smeter_cal_t) lv_event_get_user_data(e);
+
+    params_band_smeter_cal_set(cal, lv_spinbox_get_value(obj));
+}
+
+static uint8_t make_smeter_cal(uint8_t row) {
+    lv_obj_t    *obj;
+    uint8_t     col = 0;
+
+    row_dsc[row] = 54;
+
+    obj = lv_label_create(grid);
+
+    lv_label_set_text_fmt(obj, "S-meter %s\nCal, Pre, Att", params_band_label_get());
+    lv_obj_set_grid_cell(obj, LV_GRID_ALIGN_START, col++, 1, LV_GRID_ALIGN_CENTER, row, 1);
+
+    for (smeter_cal_t cal = SMETER_CAL_BASE; cal < SMETER_CAL_COUNT; cal++) {
+        obj = lv_spinbox_create(grid);
+
+        dialog_item(&dialog, obj);
+
+        lv_spinbox_set_range(obj, -40, 40);
+        lv_spinbox_set_value(obj, params_band_smeter_cal_get(cal));
+        lv_spinbox_set_digit_format(obj, 2, 0);
+        lv_spinbox_set_digit_step_direction(obj, LV_DIR_LEFT);
+        lv_obj_set_size(obj, SMALL_2, 56);
+
+        lv_obj_set_grid_cell(obj, LV_GRID_ALIGN_START, col, 2, LV_GRID_ALIGN_CENTER, row, 1);   col += 2;
+        lv_obj_add_event_cb(obj, smeter_cal_update_cb, LV_EVENT_VALUE_CHANGED, (void *) cal);
+    }
+
+    return row + 1;
+}
+
 /* Transverter */
 
 static void transverter_from_update_cb(lv_event_t * e) {
@@ -1190,6 +1267,63 @@ static uint8_t make_auto(uint8_t row) {
     return row + 1;
 }
 
+static uint8_t make_spectrum_traces(uint8_t row) {
+    lv_obj_t    *obj;
+
+    row_dsc[row] = 54;
+
+    obj = lv_label_create(grid);
+
+    lv_label_set_text(obj, "Spectrum power avg, min");
+    lv_obj_set_grid_cell(obj, LV_GRID_ALIGN_START, 0, 1, LV_GRID_ALIGN_CENTER, row, 1);
+
+    obj = lv_obj_create(grid);
+
+    lv_obj_set_size(obj, SMALL_3, 56);
+    lv_obj_set_grid_cell(obj, LV_GRID_ALIGN_START, 1, 3, LV_GRID_ALIGN_CENTER, row, 1);
+    lv_obj_set_style_bg_opa(obj, LV_OPA_TRANSP, LV_PART_MAIN);
+    lv_obj_clear_flag(obj, LV_OBJ_FLAG_SCROLLABLE);
+    lv_obj_center(obj);
+
+    obj = switch_bool(obj, &params.spectrum_power_avg);
+
+    lv_obj_set_width(obj, SMALL_3 - 30);
+
+    obj = lv_obj_create(grid);
+
+    lv_obj_set_size(obj, SMALL_3, 56);
+    lv_obj_set_grid_cell(obj, LV_GRID_ALIGN_START, 4, 3, LV_GRID_ALIGN_CENTER, row, 1);
+    lv_obj_set_style_bg_opa(obj, LV_OPA_TRANSP, LV_PART_MAIN);
+    lv_obj_clear_flag(obj, LV_OBJ_FLAG_SCROLLABLE);
+    lv_obj_center(obj);
+
+    obj = switch_bool(obj, &params.spectrum_min_hold);
+
+    lv_obj_set_width(obj, SMALL_3 - 30);
+
+    return row + 1;
+}
+
+static uint8_t make_spectrum_nfft(uint8_t row) {
+    lv_obj_t    *obj;
+    uint8_t     col = 0;
+
+    row_dsc[row] = 54;
+
+    obj = lv_label_create(grid);
+
+    lv_label_set_text(obj, "Spectrum zoom FFT");
+    lv_obj_set_grid_cell(obj, LV_GRID_ALIGN_START, col++, 1, LV_GRID_ALIGN_CENTER, row, 1);
+
+    obj = dropdown_uint8_custom_cb(grid, &params.spectrum_nfft, " 1024 \n 2048 \n 4096", spectrum_nfft_update_cb);
+
+    lv_obj_set_size(obj, SMALL_6, 56);
+    lv_obj_set_grid_cell(obj, LV_GRID_ALIGN_START, 1, 6, LV_GRID_ALIGN_CENTER, row, 1);
+    lv_obj_center(obj);
+
+    return row + 1;
+}
+
 static uint8_t make_waterfall_smooth_scroll(uint8_t row) {
     lv_obj_t    *obj;
     uint8_t     col = 0;
@@ -1268,6 +1402,58 @@ static uint8_t make_waterfall_zoom(uint8_t row) {
     return row + 1;
 }
 
+static uint8_t make_waterfall_nfft(uint8_t row) {
+    lv_obj_t    *obj;
+    uint8_t     col = 0;
+
+    row_dsc[row] = 54;
+
+    obj = lv_label_create(grid);
+
+    lv_label_set_text(obj, "Waterfall FFT");
+    lv_obj_set_grid_cell(obj, LV_GRID_ALIGN_START, col++, 1, LV_GRID_ALIGN_CENTER, row, 1);
+
+    obj = dropdown_uint8_custom_cb(grid, &params.waterfall_nfft, " 1024 \n 2048 \n 4096 \n 8192", waterfall_nfft_update_cb);
+
+    lv_obj_set_size(obj, SMALL_6, 56);
+    lv_obj_set_grid_cell(obj, LV_GRID_ALIGN_START, 1, 6, LV_GRID_ALIGN_CENTER, row, 1);
+    lv_obj_center(obj);
+
+    return row + 1;
+}
+
+static uint8_t make_governor(uint8_t row) {
+    lv_obj_t    *obj;
+
+    row_dsc[row] = 54;
+
+    obj = lv_label_create(grid);
+
+    lv_label_set_text(obj, "Render policy, load");
+    lv_obj_set_grid_cell(obj, LV_GRID_ALIGN_START, 0, 1, LV_GRID_ALIGN_CENTER, row, 1);
+
+    obj = dropdown_uint8_custom_cb(grid, &params.governor_policy, GOVERNOR_POLICY_OPTIONS, governor_policy_update_cb);
+
+    lv_obj_set_size(obj, SMALL_3, 56);
+    lv_obj_set_grid_cell(obj, LV_GRID_ALIGN_START, 1, 3, LV_GRID_ALIGN_CENTER, row, 1);
+    lv_obj_center(obj);
+
+    obj = lv_obj_create(grid);
+
+    lv_obj_set_size(obj, SMALL_3, 56);
+    lv_obj_set_grid_cell(obj, LV_GRID_ALIGN_START, 4, 3, LV_GRID_ALIGN_CENTER, row, 1);
+    lv_obj_set_style_bg_opa(obj, LV_OPA_TRANSP, LV_PART_MAIN);
+    lv_obj_clear_flag(obj, LV_OBJ_FLAG_SCROLLABLE);
+    lv_obj_center(obj);
+
+    obj = switch_bool(obj, &params.governor_readout);
+
+    lv_obj_add_event_cb(obj, governor_readout_update_cb, LV_EVENT_VALUE_CHANGED, NULL);
+    lv_obj_set_width(obj, SMALL_3 - 30);
+
+    return row + 1;
+}
+
 static uint8_t make_freq_accel(uint8_t row) {
     lv_obj_t    *obj;
     uint8_t     col = 0;
@@ -1288,6 +1474,26 @@ static uint8_t make_freq_accel(uint8_t row) {
     return row + 1;
 }
 
+static uint8_t make_iq_pretrigger(uint8_t row) {
+    lv_obj_t    *obj;
+    uint8_t     col = 0;
+
+    row_dsc[row] = 54;
+
+    obj = lv_label_create(grid);
+
+    lv_label_set_text(obj, "IQ pre-trigger");
+    lv_obj_set_grid_cell(obj, LV_GRID_ALIGN_START, col++, 1, LV_GRID_ALIGN_CENTER, row, 1);
+
+    obj = dropdown_uint8_custom_cb(grid, &params.iq_pretrigger, IQ_PRETRIGGER_OPTIONS, iq_pretrigger_update_cb);
+
+    lv_obj_set_size(obj, SMALL_6, 56);
+    lv_obj_set_grid_cell(obj, LV_GRID_ALIGN_START, 1, 6, LV_GRID_ALIGN_CENTER, row, 1);
+    lv_obj_center(obj);
+
+    return row + 1;
+}
+
 static uint8_t make_theme(uint8_t row) {
     lv_obj_t    *obj;
     uint8_t     col = 0;
@@ -1367,6 +1573,15 @@ static void construct_cb(lv_obj_t *parent) {
     row = make_delimiter(row);
     row = make_auto(row);
 
+    row = make_spectrum_traces(row);
+    row = make_delimiter(row);
+
+    row = make_spectrum_nfft(row);
+    row = make_delimiter(row);
+
+    row = make_smeter_cal(row);
+    row = make_delimiter(row);
+
     row = make_waterfall_smooth_scroll(row);
     row = make_delimiter(row);
 
@@ -1376,9 +1591,18 @@ static void construct_cb(lv_obj_t *parent) {
     row = make_waterfall_zoom(row);
     row = make_delimiter(row);
 
+    row = make_waterfall_nfft(row);
+    row = make_delimiter(row);
+
+    row = make_governor(row);
+    row = make_delimiter(row);
+
     row = make_delimiter(row);
     row = make_freq_accel(row);
 
+    row = make_delimiter(row);
+    row = make_iq_pretrigger(row);
+
     row = make_delimiter(row);
     row = make_theme(row);
 
@@ -20,10 +20,12 @@
 #include "util.h"
 #include "keyboard.h"
 #include "main_screen.h"
+#include "static_layer.h"
 
 #define STEPS   50
 
 static lv_obj_t             *chart;
+static static_layer_t       grid;
 static float                data[STEPS];
 static float                data_filtered[STEPS];
 
@@ -38,12 +40,13 @@ static uint64_t             freq_center;
 static uint64_t             freq_stop;
 
 static void construct_cb(lv_obj_t *parent);
+static void destruct_cb();
 static void key_cb(lv_event_t * e);
 
 static dialog_t             dialog = {
     .run = false,
     .construct_cb = construct_cb,
-    .destruct_cb = NULL,
+    .destruct_cb = destruct_cb,
     .audio_cb = NULL,
     .key_cb = key_cb
 };
@@ -61,6 +64,10 @@ static void do_init() {
 
     freq_start = freq_center - params.swrscan_span / 2;
     freq_stop = freq_center + params.swrscan_span / 2;
+
+    if (grid) {
+        static_layer_invalidate(grid);
+    }
 }
 
 static void do_step(float vswr) {
@@ -109,24 +116,23 @@ static lv_coord_t calc_y(float vswr) {
     return (1.0f - x) * h;
 }
 
-static void draw_cb(lv_event_t * e) {
-    lv_obj_t            *obj = lv_event_get_target(e);
-    lv_draw_ctx_t       *draw_ctx = lv_event_get_draw_ctx(e);
+/**
+ * Grid and labels, drawn once into static layer
+ */
+static void grid_draw_cb(lv_draw_ctx_t *draw_ctx, const lv_area_t *coords) {
     lv_draw_line_dsc_t  line_dsc;
     char                str[32];
 
     lv_draw_line_dsc_init(&line_dsc);
 
-    lv_coord_t x1 = obj->coords.x1;
-    lv_coord_t y1 = obj->coords.y1;
+    lv_coord_t x1 = coords->x1;
+    lv_coord_t y1 = coords->y1;
 
-    lv_coord_t w = lv_obj_get_width(obj);
-    lv_coord_t h = lv_obj_get_height(obj);
+    lv_coord_t w = lv_area_get_width(coords);
+    lv_coord_t h = lv_area_get_height(coords);
 
     lv_point_t a, b;
 
-    /* Grid */
-
     lv_area_t   area;
 
     lv_draw_label_dsc_t dsc_label;
@@ -183,6 +189,25 @@ static void draw_cb(lv_event_t * e) {
 
         lv_draw_label(draw_ctx, &dsc_label, &area, str, NULL);
     }
+}
+
+static void draw_cb(lv_event_t * e) {
+    lv_obj_t            *obj = lv_event_get_target(e);
+    lv_draw_ctx_t       *draw_ctx = lv_event_get_draw_ctx(e);
+    lv_draw_line_dsc_t  line_dsc;
+
+    lv_draw_line_dsc_init(&line_dsc);
+
+    lv_coord_t x1 = obj->coords.x1;
+    lv_coord_t y1 = obj->coords.y1;
+
+    lv_coord_t w = lv_obj_get_width(obj);
+
+    lv_point_t a, b;
+
+    /* Grid */
+
+    static_layer_draw(grid, draw_ctx, &obj->coords);
 
     /* Chart */
 
@@ -211,6 +236,7 @@ static void construct_cb(lv_obj_t *parent) {
     lv_obj_add_event_cb(dialog.obj, freq_update_cb, EVENT_FREQ_UPDATE, NULL);
 
     chart  = lv_obj_create(dialog.obj);
+    grid = static_layer_create("swrscan", grid_draw_cb);
 
     w = 780;
     h = 330;
@@ -228,6 +254,11 @@ static void construct_cb(lv_obj_t *parent) {
     do_init();
 }
 
+static void destruct_cb() {
+    static_layer_destroy(grid);
+    grid = NULL;
+}
+
 static void key_cb(lv_event_t * e) {
     uint32_t key = *((uint32_t *)lv_event_get_param(e));
 
@@ -266,6 +297,9 @@ void dialog_swrscan_scale_cb(lv_event_t * e) {
     params.swrscan_linear = !params.swrscan_linear;
     params_unlock(&params.dirty.swrscan_linear);
 
+    if (grid) {
+        static_layer_invalidate(grid);
+    }
     event_send(chart, LV_EVENT_REFRESH, NULL);
 }
 
@@ -0,0 +1,109 @@
+/*
+ *  SPDX-License-Identifier: LGPL-2.1-or-later
+ *
+ *  Xiegu X6100 LVGL GUI
+ *
+ *  Copyright (c) 2024 Georgy Dyuldin aka R2RFE
+ */
+
+#include "display.h"
+
+#include "simd/simd.h"
+
+#define BUF_SIZE        (DISPLAY_WIDTH * DISPLAY_HEIGHT)
+#define DAMAGE_MAX      16
+
+_Static_assert(sizeof(lv_color_t) == sizeof(uint32_t), "LV_COLOR_DEPTH 32 is expected");
+
+static const display_backend_t  *backend;
+
+static lv_color_t               buf[BUF_SIZE];
+static lv_disp_draw_buf_t       disp_buf;
+static lv_disp_drv_t            disp_drv;
+
+static lv_area_t                damage[DAMAGE_MAX];
+static uint16_t                 damage_count = 0;
+
+/**
+ * Keep separate areas while there is a room, then merge all of them
+ */
+static void damage_add(const lv_area_t *area) {
+    for (uint16_t i = 0; i < damage_count; i++) {
+        if (_lv_area_is_in(area, &damage[i], 0)) {
+            return;
+        }
+    }
+
+    if (damage_count < DAMAGE_MAX) {
+        damage[damage_count++] = *area;
+        return;
+    }
+
+    for (uint16_t i = 1; i < damage_count; i++) {
+        _lv_area_join(&damage[0], &damage[0], &damage[i]);
+    }
+
+    _lv_area_join(&damage[0], &damage[0], area);
+    damage_count = 1;
+}
+
+/**
+ * Landscape (x, y) is native (y, DISPLAY_NATIVE_H - 1 - x)
+ */
+static void flush_cb(lv_disp_drv_t *drv, const lv_area_t *area, lv_color_t *color_p) {
+    uint32_t    stride;
+    uint32_t    *page = backend->page(&stride);
+
+    if (page) {
+        lv_area_t   native = {
+            .x1 = area->y1,
+            .y1 = DISPLAY_NATIVE_H - 1 - area->x2,
+            .x2 = area->y2,
+            .y2 = DISPLAY_NATIVE_H - 1 - area->x1
+        };
+
+        simd_rotate90_u32((const uint32_t *) color_p, lv_area_get_width(area),
+                          lv_area_get_width(area), lv_area_get_height(area),
+                          page + native.y1 * stride + native.x1, stride);
+
+        damage_add(&native);
+    }
+
+    if (lv_disp_flush_is_last(drv)) {
+        if (backend->present && damage_count) {
+            backend->present(damage, damage_count);
+        }
+        damage_count = 0;
+    }
+
+    lv_disp_flush_ready(drv);
+}
+
+lv_disp_drv_t * display_init(const display_backend_t *b) {
+    uint32_t stride;
+
+    backend = b;
+
+    lv_disp_draw_buf_init(&disp_buf, buf, NULL, BUF_SIZE);
+    lv_disp_drv_init(&disp_drv);
+
+    disp_drv.draw_buf = &disp_buf;
+
+    if (backend->page(&stride)) {
+        disp_drv.flush_cb = flush_cb;
+        disp_drv.hor_res = DISPLAY_WIDTH;
+        disp_drv.ver_res = DISPLAY_HEIGHT;
+    } else {
+        LV_LOG_WARN("No direct access to framebuffer, LVGL rotation is used");
+
+        disp_drv.flush_cb = backend->flush;
+        disp_drv.hor_res = DISPLAY_NATIVE_W;
+        disp_drv.ver_res = DISPLAY_NATIVE_H;
+        disp_drv.sw_rotate = 1;
+        disp_drv.rotated = LV_DISP_ROT_90;
+    }
+
+    lv_disp_drv_register(&disp_drv);
+
+    return &disp_drv;
+}
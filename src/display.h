@@ -0,0 +1,45 @@
+/*
+ *  SPDX-License-Identifier: LGPL-2.1-or-later
+ *
+ *  Xiegu X6100 LVGL GUI
+ *
+ *  Copyright (c) 2024 Georgy Dyuldin aka R2RFE
+ */
+
+#pragma once
+
+#include "lvgl/lvgl.h"
+
+#include <stdint.h>
+
+/* Landscape UI on portrait panel */
+#define DISPLAY_WIDTH       800
+#define DISPLAY_HEIGHT      480
+#define DISPLAY_NATIVE_W    DISPLAY_HEIGHT
+#define DISPLAY_NATIVE_H    DISPLAY_WIDTH
+
+/**
+ * Display pipeline. LVGL renders landscape areas, flush rotates them by
+ * tiles straight into the native (portrait) page of the backend, so
+ * there is no LVGL sw_rotate with its intermediate buffer and no extra
+ * copy. Backend without a page gets LVGL rotated areas as before.
+ */
+typedef struct {
+    /**
+     * Native page to draw into, stride in pixels. NULL if backend can't
+     * give direct access to 32 bit pixels
+     */
+    uint32_t *  (*page)(uint32_t *stride);
+
+    /**
+     * Frame is complete, damaged areas are in native coords. Optional
+     */
+    void        (*present)(const lv_area_t *damage, uint16_t count);
+
+    /**
+     * Flush of rotated areas, used without page
+     */
+    void        (*flush)(lv_disp_drv_t *drv, const lv_area_t *area, lv_color_t *color_p);
+} display_backend_t;
+
+lv_disp_drv_t * display_init(const display_backend_t *backend);
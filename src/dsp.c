@@ -8,7 +8,10 @@
 
 #include <stdlib.h>
 #include <stdbool.h>
+#include <string.h>
 #include <pthread.h>
+#include <semaphore.h>
+#include <stdatomic.h>
 #include <math.h>
 
 #include "dsp.h"
@@ -18,58 +21,125 @@
 #include "radio.h"
 #include "meter.h"
 #include "audio.h"
-#include "cw.h"
-#include "rtty.h"
 #include "dialog_ft8.h"
 #include "dialog_msg_voice.h"
-#include "recorder.h"
+#include "spsc_ring.h"
+#include "audio_bus.h"
+#include "dsp/quantile.h"
+#include "dsp/halfband.h"
+#include "dsp/trace.h"
+#include "dsp/smeter.h"
+#include "dsp/binmap.h"
+#include "dsp/hilbert.h"
+#include "params/params.h"
+#include "simd/simd.h"
+#include "governor.h"
+
+#define IQ_RING_BLOCKS  32
+#define SPECTRUM_LEVELS 5   /* Zoom x1, x2, x4, x8, x16 */
+#define SPECTRUM_REF_FPS 15 /* Beta and peak speed params are per frame at this rate */
+#define HANN_ENBW       1.5f
+#define SMETER_ATTACK_MS 40
+#define SMETER_DECAY_MS 180
+
+typedef struct {
+    bool            tx;
+    uint16_t        size;
+    float complex   samples[RADIO_SAMPLES];
+} iq_block_t;
+
+/**
+ * One level of spectrum pyramid. Each level decimates the previous one by 2,
+ * all levels are processed all the time, so zoom change only switches the
+ * level to display. Level x1 has the same samples as waterfall, so it has
+ * no own spectrogram and is remapped from waterfall PSD
+ */
+typedef struct {
+    halfband_t      decim;      /* From previous level, NULL for x1 */
+    spgramcf        sg;         /* NULL for x1 */
+    spgramcf        wf_hires;   /* Waterfall of this level, NULL for x1 with default size */
+    float complex   *buf;
+} spectrum_level_t;
+
+static spsc_ring_t      iq_ring;
+static sem_t            iq_sem;
+static atomic_bool      reset_request = false;
+static uint32_t         iq_overruns = 0;
 
 static iirfilt_cccf     dc_block;
 
-static pthread_mutex_t  spectrum_mux = PTHREAD_MUTEX_INITIALIZER;
-
-static uint8_t          spectrum_factor = 1;
-static firdecim_crcf    spectrum_decim_rx;
-static firdecim_crcf    spectrum_decim_tx;
+static spectrum_level_t spectrum_rx[SPECTRUM_LEVELS];
+static spectrum_level_t spectrum_tx[SPECTRUM_LEVELS];
+static atomic_uchar     spectrum_level = 0;
+static uint8_t          spectrum_level_shown = 0xFF;
 
-static spgramcf         spectrum_sg_rx;
-static spgramcf         spectrum_sg_tx;
 static float            *spectrum_psd;
-static float            *spectrum_psd_filtered;
+static float            *spectrum_fft_psd;
+static uint16_t         spectrum_nfft = 0;
+static atomic_ushort    spectrum_nfft_request = 0;
+static binmap_t         spectrum_binmap;        /* Zoomed levels, spectrum_nfft to SPECTRUM_SIZE */
+static binmap_t         spectrum_binmap_x1;     /* Waterfall PSD to SPECTRUM_SIZE */
+static trace_t          spectrum_trace;
 static float            spectrum_beta = 0.7f;
-static uint8_t          spectrum_fps_ms = (1000 / 15);
+static float            spectrum_tau_ms;
+static atomic_int       spectrum_shift = 0;
+static atomic_bool      spectrum_clear_request = false;
+static atomic_uchar     spectrum_fps_ms = (1000 / 15);
 static uint64_t         spectrum_time;
-static float complex    *spectrum_dec_buf;
 
 static spgramcf         waterfall_sg_rx;
 static spgramcf         waterfall_sg_tx;
 static float            *waterfall_psd;
-static uint8_t          waterfall_fps_ms = (1000 / 25);
+static bool             waterfall_psd_fresh = false;
+static atomic_uchar     waterfall_fps_ms = (1000 / 25);
+
+/* High resolution waterfall on stream of pyramid level */
+static float            *waterfall_hires_psd;
+static uint16_t         waterfall_nfft = WATERFALL_NFFT;
+static uint8_t          waterfall_level = 0;
+static uint32_t         waterfall_hires_samples;
+static uint8_t          waterfall_hires_fps_ms;     /* Rate the hop is computed for */
+static atomic_ushort    waterfall_nfft_request = 0;
 static uint64_t         waterfall_time;
 
 static float complex    buf_filtered[RADIO_SAMPLES];
 
+static smeter_t         s_meter;
+static uint64_t         s_meter_time;
+static float            s_meter_bandwidth_db = 0.0f;
+
 static uint8_t          psd_delay;
 static uint8_t          min_max_delay;
+static quantile_t       min_max_quantile;
 
-static firhilbf         audio_hilb;
-static float complex    *audio;
+static hilbert_t        audio_hilb;
+static float            audio_real[AUDIO_BUS_BLOCK];
 
 static bool             ready = false;
 
 static void dsp_update_min_max(float *data_buf, uint16_t size);
-static void setup_spectrum_spgram();
+static void setup_spectrum_levels(spectrum_level_t *levels);
+static void setup_spectrum_nfft(uint16_t nfft);
+static void setup_waterfall_nfft(uint16_t nfft);
+static void setup_waterfall_level(uint8_t level);
+static void * dsp_thread(void *arg);
+static void dialog_audio_cb(const audio_block_t *block, void *user);
 
 /* * */
 
 void dsp_init(uint8_t factor) {
     dc_block = iirfilt_cccf_create_dc_blocker(0.005f);
 
-    setup_spectrum_spgram();
+    setup_spectrum_levels(spectrum_rx);
+    setup_spectrum_levels(spectrum_tx);
+    /* Loaded params are not checked against limits */
+    setup_spectrum_nfft(SPECTRUM_NFFT_MIN << LV_MIN(params.spectrum_nfft.x, params.spectrum_nfft.max));
 
-    spectrum_psd = malloc(SPECTRUM_NFFT * sizeof(float));
-    spectrum_psd_filtered = malloc(SPECTRUM_NFFT * sizeof(float));
+    spectrum_psd = malloc(SPECTRUM_SIZE * sizeof(float));
+    spectrum_fft_psd = malloc(SPECTRUM_NFFT_MAX * sizeof(float));
+    spectrum_trace = trace_create(SPECTRUM_SIZE);
     dsp_set_spectrum_factor(factor);
+    dsp_set_spectrum_beta(spectrum_beta);
 
     waterfall_sg_rx = spgramcf_create(WATERFALL_NFFT, LIQUID_WINDOW_HANN, WATERFALL_NFFT, WATERFALL_NFFT / 4);
     spgramcf_set_alpha(waterfall_sg_rx, 0.2f);
@@ -77,69 +147,162 @@ void dsp_init(uint8_t factor) {
     spgramcf_set_alpha(waterfall_sg_tx, 0.2f);
 
     waterfall_psd = malloc(WATERFALL_NFFT * sizeof(float));
+    waterfall_hires_psd = malloc(WATERFALL_NFFT_MAX * sizeof(float));
+    setup_waterfall_nfft(WATERFALL_NFFT << LV_MIN(params.waterfall_nfft.x, params.waterfall_nfft.max));
+    spectrum_binmap_x1 = binmap_create(WATERFALL_NFFT, SPECTRUM_SIZE);
+    min_max_quantile = quantile_create(S_MIN - 30.0f, 0.0f, 0.25f);
+
+    s_meter = smeter_create();
+    smeter_set_ballistics(s_meter, SMETER_ATTACK_MS, SMETER_DECAY_MS);
+    s_meter_time = get_time();
 
     spectrum_time = get_time();
     waterfall_time = get_time();
 
     psd_delay = 4;
 
-    audio = (float complex *) malloc(AUDIO_CAPTURE_RATE * sizeof(float complex));
-    audio_hilb = firhilbf_create(7, 60.0f);
+    audio_hilb = hilbert_create(7, 60.0f);
+    audio_bus_init();
+    audio_bus_subscribe(dialog_audio_cb, NULL, 0);
+
+    iq_ring = spsc_ring_create(sizeof(iq_block_t), IQ_RING_BLOCKS);
+    sem_init(&iq_sem, 0, 0);
+
+    pthread_t thread;
+
+    pthread_create(&thread, NULL, dsp_thread, NULL);
+    pthread_detach(thread);
 
     ready = true;
 }
 
+/**
+ * Request reset of DSP state. Done on DSP thread before next block
+ */
 void dsp_reset() {
+    atomic_store(&reset_request, true);
+    sem_post(&iq_sem);
+}
+
+static void do_reset() {
+    spsc_ring_flush(iq_ring);
     psd_delay = 4;
 
     iirfilt_cccf_reset(dc_block);
-    spgramcf_reset(spectrum_sg_rx);
+
+    for (uint8_t i = 1; i < SPECTRUM_LEVELS; i++) {
+        spgramcf_reset(spectrum_rx[i].sg);
+    }
     spgramcf_reset(waterfall_sg_rx);
+    setup_waterfall_level(waterfall_level);
+    smeter_reset(s_meter);
 }
 
 static void process_samples(
     float complex *buf_samples, uint16_t size,
-    firdecim_crcf sp_decim, spgramcf sp_sg,
-    spgramcf wf_sg
+    spectrum_level_t *levels, spgramcf wf_sg, spgramcf wf_hires
 ) {
     iirfilt_cccf_execute_block(dc_block, buf_samples, size, buf_filtered);
 
-    if (spectrum_factor > 1) {
-        firdecim_crcf_execute_block(sp_decim, buf_filtered, size / spectrum_factor, spectrum_dec_buf);
-        spgramcf_write(sp_sg, spectrum_dec_buf, size / spectrum_factor);
-    } else {
-        spgramcf_write(sp_sg, buf_filtered, size);
+    spgramcf_write(wf_sg, buf_filtered, size);
+
+    float complex *buf = buf_filtered;
+
+    for (uint8_t i = 1; i < SPECTRUM_LEVELS; i++) {
+        if (wf_hires && waterfall_level == i - 1) {
+            spgramcf_write(wf_hires, buf, size);
+            waterfall_hires_samples += size;
+        }
+        halfband_execute(levels[i].decim, buf, size, levels[i].buf);
+        size /= 2;
+        spgramcf_write(levels[i].sg, levels[i].buf, size);
+        buf = levels[i].buf;
     }
 
-    spgramcf_write(wf_sg, buf_filtered, size);
+    if (wf_hires && waterfall_level == SPECTRUM_LEVELS - 1) {
+        spgramcf_write(wf_hires, buf, size);
+        waterfall_hires_samples += size;
+    }
+}
+
+static void setup_spectrum_trace(uint8_t level) {
+    /* Shorter averaging for high zoom, each frame has less new samples there */
+    float tau = spectrum_tau_ms / (((float) (1 << level) - 1.0f) / 2.0f + 1.0f);
+
+    trace_set_avg(spectrum_trace, params.spectrum_power_avg.x ? TRACE_AVG_POWER : TRACE_AVG_DB, tau);
+    trace_set_hold(spectrum_trace, params.spectrum_peak_hold, params.spectrum_peak_speed * SPECTRUM_REF_FPS);
 }
 
-static bool update_spectrum(spgramcf sp_sg, uint64_t now, bool tx) {
+/**
+ * Full span PSD, shared by waterfall, S-meter and spectrum x1. Taken once per block
+ */
+static float * get_waterfall_psd(spgramcf wf_sg) {
+    if (!waterfall_psd_fresh) {
+        spgramcf_get_psd(wf_sg, waterfall_psd);
+        simd_add_scalar_f32(waterfall_psd, WATERFALL_NFFT, -30.0f, waterfall_psd);
+        waterfall_psd_fresh = true;
+    }
+    return waterfall_psd;
+}
+
+static bool update_spectrum(spectrum_level_t *levels, spgramcf wf_sg, uint64_t now, bool tx) {
     if ((now - spectrum_time > spectrum_fps_ms) && (!psd_delay)) {
-        spgramcf_get_psd(sp_sg, spectrum_psd);
-        liquid_vectorf_addscalar(spectrum_psd, SPECTRUM_NFFT, -30.0f, spectrum_psd);
-        // Decrease beta for high zoom
-        float new_beta = powf(spectrum_beta, ((float) spectrum_factor - 1.0f) / 2.0f + 1.0f);
-        lpf_block(spectrum_psd_filtered, spectrum_psd, new_beta, SPECTRUM_NFFT);
-        spectrum_data(spectrum_psd_filtered, SPECTRUM_NFFT, tx);
+        uint8_t level = atomic_load(&spectrum_level);
+        float   dt = LV_MIN(now - spectrum_time, 1000);
+
+        if (level == 0) {
+            binmap_execute(spectrum_binmap_x1, get_waterfall_psd(wf_sg), spectrum_psd, BINMAP_MAX);
+        } else {
+            spgramcf_get_psd(levels[level].sg, spectrum_fft_psd);
+            binmap_execute(spectrum_binmap, spectrum_fft_psd, spectrum_psd, BINMAP_MAX);
+            simd_add_scalar_f32(spectrum_psd, SPECTRUM_SIZE, -30.0f, spectrum_psd);
+        }
+
+        if (atomic_exchange(&spectrum_clear_request, false) || level != spectrum_level_shown) {
+            /* Level is warm, show it without smoothing from previous zoom */
+            trace_reset(spectrum_trace);
+            spectrum_level_shown = level;
+        }
+
+        setup_spectrum_trace(level);
+        trace_shift(spectrum_trace, atomic_exchange(&spectrum_shift, 0));
+        trace_put(spectrum_trace, spectrum_psd, dt, !tx);
+
+        spectrum_data(
+            trace_avg(spectrum_trace),
+            params.spectrum_peak ? trace_max(spectrum_trace) : NULL,
+            params.spectrum_min_hold.x ? trace_min(spectrum_trace) : NULL,
+            SPECTRUM_SIZE, tx
+        );
         spectrum_time = now;
         return true;
     }
     return false;
 }
 
-static bool update_waterfall(spgramcf wf_sg, uint64_t now, bool tx) {
+static bool update_waterfall(spgramcf wf_sg, spgramcf wf_hires, uint64_t now, bool tx) {
     if ((now - waterfall_time > waterfall_fps_ms) && (!psd_delay)) {
-        spgramcf_get_psd(wf_sg, waterfall_psd);
-        liquid_vectorf_addscalar(waterfall_psd, WATERFALL_NFFT, -30.0f, waterfall_psd);
-        waterfall_data(waterfall_psd, WATERFALL_NFFT, tx);
+        if (!wf_hires) {
+            waterfall_data(get_waterfall_psd(wf_sg), WATERFALL_NFFT, 100000, tx);
+        } else if (waterfall_hires_samples >= waterfall_nfft) {
+            spgramcf_get_psd(wf_hires, waterfall_hires_psd);
+            simd_add_scalar_f32(waterfall_hires_psd, waterfall_nfft, -30.0f, waterfall_hires_psd);
+            waterfall_data(waterfall_hires_psd, waterfall_nfft, 100000 >> waterfall_level, tx);
+        }
         waterfall_time = now;
         return true;
     }
     return false;
 }
 
-static void update_s_meter(){
+/**
+ * Channel power of the filter passband from waterfall PSD
+ */
+static void update_s_meter(const float *psd, uint64_t now) {
+    float dt = LV_MIN(now - s_meter_time, 1000);
+
+    s_meter_time = now;
+
     if (dialog_msg_voice_get_state() != MSG_VOICE_RECORD) {
         int32_t filter_from, filter_to;
         int32_t from, to;
@@ -148,101 +311,207 @@ static void update_s_meter(){
 
         from = WATERFALL_NFFT / 2;
         from -= filter_to * WATERFALL_NFFT / 100000;
+        from = limit(from, 0, WATERFALL_NFFT - 1);
 
         to = WATERFALL_NFFT / 2;
         to -= filter_from * WATERFALL_NFFT / 100000;
+        to = limit(to, from, WATERFALL_NFFT - 1);
 
-        int16_t peak_db = -121;
+        float db = smeter_channel_power(psd, from, to, HANN_ENBW);
 
-        for (int32_t i = from; i <= to; i++)
-            if (waterfall_psd[i] > peak_db)
-                peak_db = waterfall_psd[i];
+        db += params_band_smeter_offset_get();
+        s_meter_bandwidth_db = smeter_bandwidth_db(to - from + 1, HANN_ENBW);
 
-        meter_update(peak_db, 0.8f);
+        meter_update(smeter_put(s_meter, db, dt), 0.0f);
     }
 }
 
-void dsp_samples(float complex *buf_samples, uint16_t size, bool tx) {
-    firdecim_crcf sp_decim;
-    spgramcf sp_sg, wf_sg;
+static void process_block(float complex *buf_samples, uint16_t size, bool tx) {
+    spectrum_level_t *levels;
+    spgramcf wf_sg, wf_hires;
     uint64_t now = get_time();
 
     if (psd_delay) {
         psd_delay--;
     }
 
-    pthread_mutex_lock(&spectrum_mux);
+    uint16_t nfft = atomic_exchange(&spectrum_nfft_request, 0);
+
+    if (nfft && nfft != spectrum_nfft) {
+        setup_spectrum_nfft(nfft);
+        trace_reset(spectrum_trace);
+    }
+
+    uint16_t    wf_nfft = atomic_exchange(&waterfall_nfft_request, 0);
+    uint8_t     wf_level = params.waterfall_zoom.x ? atomic_load(&spectrum_level) : 0;
+
+    if (!wf_nfft) {
+        wf_nfft = waterfall_nfft;
+    }
+
+    /* Hop follows waterfall rate, which is changed by governor */
+    if (wf_nfft != waterfall_nfft || atomic_load(&waterfall_fps_ms) != waterfall_hires_fps_ms) {
+        setup_waterfall_nfft(wf_nfft);
+    }
+
+    if (wf_level != waterfall_level) {
+        setup_waterfall_level(wf_level);
+    }
+
     if (tx) {
-        sp_decim = spectrum_decim_tx;
-        sp_sg = spectrum_sg_tx;
+        levels = spectrum_tx;
         wf_sg = waterfall_sg_tx;
     } else {
-        sp_decim = spectrum_decim_rx;
-        sp_sg = spectrum_sg_rx;
+        levels = spectrum_rx;
         wf_sg = waterfall_sg_rx;
     }
-    process_samples(buf_samples, size, sp_decim, sp_sg, wf_sg);
-    update_spectrum(sp_sg, now, tx);
-    pthread_mutex_unlock(&spectrum_mux);
-    if (update_waterfall(wf_sg, now, tx)) {
-        update_s_meter();
+    wf_hires = levels[waterfall_level].wf_hires;
+    process_samples(buf_samples, size, levels, wf_sg, wf_hires);
+    waterfall_psd_fresh = false;
+    update_spectrum(levels, wf_sg, now, tx);
+
+    if (update_waterfall(wf_sg, wf_hires, now, tx)) {
+        float *psd = get_waterfall_psd(wf_sg);
+
+        update_s_meter(psd, now);
         // TODO: skip on disabled auto min/max
         if (!tx) {
-            dsp_update_min_max(waterfall_psd, WATERFALL_NFFT);
+            dsp_update_min_max(psd, WATERFALL_NFFT);
         } else {
             min_max_delay = 2;
         }
     }
 }
 
-void dsp_set_spectrum_factor(uint8_t x) {
-    if (x == spectrum_factor)
+/**
+ * Called from radio thread. Only copy the block to the ring, never block
+ */
+void dsp_samples(float complex *buf_samples, uint16_t size, bool tx) {
+    if (!ready) {
         return;
+    }
 
-    pthread_mutex_lock(&spectrum_mux);
-
-    spectrum_factor = x;
+    iq_block_t *block = spsc_ring_write_begin(iq_ring);
 
-    setup_spectrum_spgram();
+    if (!block) {
+        return;
+    }
 
-    if (spectrum_decim_rx) {
-        firdecim_crcf_destroy(spectrum_decim_rx);
-        spectrum_decim_rx = NULL;
+    if (size > RADIO_SAMPLES) {
+        size = RADIO_SAMPLES;
     }
 
-    if (spectrum_decim_tx) {
-        firdecim_crcf_destroy(spectrum_decim_tx);
-        spectrum_decim_tx = NULL;
+    block->tx = tx;
+    block->size = size;
+    memcpy(block->samples, buf_samples, size * sizeof(float complex));
+
+    spsc_ring_write_commit(iq_ring);
+    sem_post(&iq_sem);
+}
+
+uint32_t dsp_get_overruns() {
+    return spsc_ring_overruns(iq_ring);
+}
+
+size_t dsp_get_queued() {
+    return spsc_ring_size(iq_ring);
+}
+
+static void * dsp_thread(void *arg) {
+    iq_block_t *block;
+
+    while (true) {
+        sem_wait(&iq_sem);
+
+        if (atomic_exchange(&reset_request, false)) {
+            do_reset();
+        }
+
+        while ((block = spsc_ring_read_begin(iq_ring))) {
+            uint64_t begin = governor_time_us();
+
+            process_block(block->samples, block->size, block->tx);
+            spsc_ring_read_commit(iq_ring);
+            governor_add(GOVERNOR_DSP, begin);
+        }
+
+        uint32_t overruns = spsc_ring_overruns(iq_ring);
+
+        if (overruns != iq_overruns) {
+            LV_LOG_WARN("DSP ring overrun (total %u)", overruns);
+            iq_overruns = overruns;
+        }
     }
+    return NULL;
+}
 
-    if (spectrum_dec_buf) {
-        free(spectrum_dec_buf);
-        spectrum_dec_buf = NULL;
+/**
+ * Frame rates of spectrum and waterfall, set by governor
+ */
+void dsp_set_fps(uint8_t spectrum_fps, uint8_t waterfall_fps) {
+    atomic_store(&spectrum_fps_ms, 1000 / LV_MAX(spectrum_fps, 5));
+    atomic_store(&waterfall_fps_ms, 1000 / LV_MAX(waterfall_fps, 5));
+}
+
+void dsp_set_waterfall_nfft(uint16_t nfft) {
+    if (nfft < WATERFALL_NFFT) {
+        nfft = WATERFALL_NFFT;
+    } else if (nfft > WATERFALL_NFFT_MAX) {
+        nfft = WATERFALL_NFFT_MAX;
     }
 
-    if (spectrum_factor > 1) {
-        spectrum_decim_rx = firdecim_crcf_create_kaiser(spectrum_factor, 16, 40.0f);
-        firdecim_crcf_set_scale(spectrum_decim_rx, sqrt(1.0f/(float)spectrum_factor));
-        spectrum_decim_tx = firdecim_crcf_create_kaiser(spectrum_factor, 16, 40.0f);
-        firdecim_crcf_set_scale(spectrum_decim_tx, sqrt(1.0f/(float)spectrum_factor));
-        spectrum_dec_buf = (float complex *) malloc(RADIO_SAMPLES * sizeof(float complex) / spectrum_factor);
+    atomic_store(&waterfall_nfft_request, nfft);
+}
+
+void dsp_set_spectrum_nfft(uint16_t nfft) {
+    if (nfft < SPECTRUM_NFFT_MIN) {
+        nfft = SPECTRUM_NFFT_MIN;
+    } else if (nfft > SPECTRUM_NFFT_MAX) {
+        nfft = SPECTRUM_NFFT_MAX;
     }
 
-    spgramcf_reset(spectrum_sg_rx);
-    spgramcf_reset(spectrum_sg_tx);
+    atomic_store(&spectrum_nfft_request, nfft);
+}
+
+/**
+ * Select displayed level of spectrum pyramid. Factor is rounded down to power of 2
+ */
+void dsp_set_spectrum_factor(uint8_t x) {
+    uint8_t level = 0;
 
-    for (uint16_t i = 0; i < SPECTRUM_NFFT; i++)
-        spectrum_psd_filtered[i] = S_MIN;
+    while ((level < SPECTRUM_LEVELS - 1) && ((2 << level) <= x)) {
+        level++;
+    }
 
-    pthread_mutex_unlock(&spectrum_mux);
+    atomic_store(&spectrum_level, level);
 }
 
 float dsp_get_spectrum_beta() {
     return spectrum_beta;
 }
 
+/**
+ * Beta is smoothing per frame at SPECTRUM_REF_FPS, converted to time constant
+ */
 void dsp_set_spectrum_beta(float x) {
     spectrum_beta = x;
+    spectrum_tau_ms = (x > 0.0f) ? -1000.0f / SPECTRUM_REF_FPS / logf(x) : 0.0f;
+}
+
+float dsp_get_spectrum_avg_ms() {
+    return spectrum_tau_ms;
+}
+
+void dsp_spectrum_shift(int16_t bins) {
+    atomic_fetch_add(&spectrum_shift, bins);
+}
+
+void dsp_spectrum_clear() {
+    atomic_store(&spectrum_clear_request, true);
+}
+
+static void dialog_audio_cb(const audio_block_t *block, void *user) {
+    dialog_audio_samples(block->n, block->analytic);
 }
 
 void dsp_put_audio_samples(size_t nsamples, int16_t *samples) {
@@ -255,29 +524,24 @@ void dsp_put_audio_samples(size_t nsamples, int16_t *samples) {
         return;
     }
 
-    if (recorder_is_on()) {
-        recorder_put_audio_samples(nsamples, samples);
-    }
-
-    for (uint16_t i = 0; i < nsamples; i++)
-        firhilbf_r2c_execute(audio_hilb, samples[i] / 32768.0f, &audio[i]);
+    while (nsamples) {
+        audio_block_t   *block = audio_bus_acquire();
+        size_t          n = nsamples < AUDIO_BUS_BLOCK ? nsamples : AUDIO_BUS_BLOCK;
 
-    x6100_mode_t    mode = radio_current_mode();
+        if (!block) {
+            return;
+        }
 
-    if (rtty_get_state() == RTTY_RX) {
-        rtty_put_audio_samples(nsamples, audio);
-    } else if (mode == x6100_mode_cw || mode == x6100_mode_cwr) {
-        cw_put_audio_samples(nsamples, audio);
-    } else {
-        dialog_audio_samples(nsamples, audio);
-    }
-}
+        memcpy(block->raw, samples, n * sizeof(int16_t));
+        simd_s16_to_f32(samples, n, 1.0f / 32768.0f, audio_real);
+        hilbert_execute(audio_hilb, audio_real, n, block->analytic);
 
-static int compare_fft(const void *p1, const void *p2) {
-    float *i1 = (float *) p1;
-    float *i2 = (float *) p2;
+        block->n = n;
+        audio_bus_publish(block);
 
-    return (*i1 < *i2) ? -1 : 1;
+        samples += n;
+        nsamples -= n;
+    }
 }
 
 static void dsp_update_min_max(float *data_buf, uint16_t size) {
@@ -285,13 +549,16 @@ static void dsp_update_min_max(float *data_buf, uint16_t size) {
         min_max_delay--;
         return;
     }
-    qsort(data_buf, size, sizeof(float), compare_fft);
     uint16_t    min_nth = 15;
     uint16_t    max_nth = 10;
 
-    float       min = data_buf[min_nth];
-    float       max = data_buf[size - max_nth - 1];
+    quantile_reset(min_max_quantile);
+    quantile_put(min_max_quantile, data_buf, size);
+
+    float       min = quantile_get_nth(min_max_quantile, min_nth);
+    float       max = quantile_get_nth(min_max_quantile, size - max_nth - 1);
 
+    meter_update_noise(quantile_get(min_max_quantile, 0.5f) + s_meter_bandwidth_db + params_band_smeter_offset_get());
 
     if (max > S9_40) {
         max = S9_40;
@@ -311,19 +578,104 @@ static void dsp_update_min_max(float *data_buf, uint16_t size) {
     waterfall_update_max(max);
 }
 
-static void setup_spectrum_spgram() {
-    if (spectrum_sg_rx) {
-        spgramcf_destroy(spectrum_sg_rx);
+static void setup_spectrum_levels(spectrum_level_t *levels) {
+    for (uint8_t i = 0; i < SPECTRUM_LEVELS; i++) {
+        spectrum_level_t    *level = &levels[i];
+        uint16_t            factor = 1 << i;
+
+        level->sg = NULL;
+        level->wf_hires = NULL;
+
+        if (i == 0) {
+            level->decim = NULL;
+            level->buf = NULL;
+        } else {
+            /* Same gain per stage as Kaiser firdecim (x2) with 1/sqrt(2) scale */
+            level->decim = halfband_create(70.0f);
+            halfband_set_scale(level->decim, sqrtf(2.0f));
+            level->buf = (float complex *) malloc(RADIO_SAMPLES / factor * sizeof(float complex));
+        }
     }
-    if (spectrum_sg_tx) {
-        spgramcf_destroy(spectrum_sg_tx);
+}
+
+/**
+ * (Re)create spectrograms of zoomed levels. Power of two sizes only, mixed
+ * radix FFT of display width is much slower
+ */
+static void setup_spectrum_nfft(uint16_t nfft) {
+    spectrum_level_t *all[] = { spectrum_rx, spectrum_tx };
+
+    for (uint8_t n = 0; n < 2; n++) {
+        for (uint8_t i = 1; i < SPECTRUM_LEVELS; i++) {
+            spectrum_level_t    *level = &all[n][i];
+            uint16_t            factor = 1 << i;
+            uint16_t            window = nfft * 3 / 2 / factor;
+
+            if (nfft < window) {
+                window = nfft;
+            }
+
+            if (level->sg) {
+                spgramcf_destroy(level->sg);
+            }
+
+            level->sg = spgramcf_create(nfft, LIQUID_WINDOW_HANN, window, nfft / 4);
+            spgramcf_set_alpha(level->sg, 0.4f);
+        }
     }
-    uint16_t window = SPECTRUM_NFFT * 3 / 2 / spectrum_factor;
-    if (SPECTRUM_NFFT < window) {
-        window = SPECTRUM_NFFT;
+
+    if (spectrum_binmap) {
+        binmap_destroy(spectrum_binmap);
     }
-    spectrum_sg_rx = spgramcf_create(SPECTRUM_NFFT, LIQUID_WINDOW_HANN, window, SPECTRUM_NFFT / 4);
-    spgramcf_set_alpha(spectrum_sg_rx, 0.4f);
-    spectrum_sg_tx = spgramcf_create(SPECTRUM_NFFT, LIQUID_WINDOW_HANN, window, SPECTRUM_NFFT / 4);
-    spgramcf_set_alpha(spectrum_sg_tx, 0.4f);
+
+    spectrum_binmap = binmap_create(nfft, SPECTRUM_SIZE);
+    spectrum_nfft = nfft;
+}
+
+/**
+ * (Re)create waterfall spectrograms of nfft on the stream of each pyramid
+ * level, with the hop of current waterfall rate. Full span with default size is already computed, then no own
+ * spectrogram for x1
+ */
+static void setup_waterfall_nfft(uint16_t nfft) {
+    spectrum_level_t *all[] = { spectrum_rx, spectrum_tx };
+
+    waterfall_hires_fps_ms = atomic_load(&waterfall_fps_ms);
+
+    for (uint8_t n = 0; n < 2; n++) {
+        for (uint8_t i = 0; i < SPECTRUM_LEVELS; i++) {
+            spectrum_level_t *level = &all[n][i];
+
+            if (level->wf_hires) {
+                spgramcf_destroy(level->wf_hires);
+                level->wf_hires = NULL;
+            }
+
+            if (nfft == WATERFALL_NFFT && i == 0) {
+                continue;
+            }
+
+            /* At least one transform per row on slow decimated streams */
+            uint16_t delay = LV_MIN(nfft / 4, (100000 >> i) * waterfall_hires_fps_ms / 1000);
+
+            level->wf_hires = spgramcf_create(nfft, LIQUID_WINDOW_HANN, nfft, delay);
+            spgramcf_set_alpha(level->wf_hires, 0.2f);
+        }
+    }
+
+    waterfall_nfft = nfft;
+    setup_waterfall_level(waterfall_level);
+}
+
+/**
+ * Only the shown level gets samples, start it from scratch
+ */
+static void setup_waterfall_level(uint8_t level) {
+    if (spectrum_rx[level].wf_hires) {
+        spgramcf_reset(spectrum_rx[level].wf_hires);
+        spgramcf_reset(spectrum_tx[level].wf_hires);
+    }
+
+    waterfall_level = level;
+    waterfall_hires_samples = 0;
 }
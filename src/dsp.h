@@ -12,16 +12,60 @@
 #include <stdlib.h>
 #include <liquid/liquid.h>
 
-#define WATERFALL_NFFT  1024
-#define SPECTRUM_NFFT   800
+#define WATERFALL_NFFT  1024    /* Full span PSD for waterfall, S-meter, spectrum x1 */
+#define WATERFALL_NFFT_MAX  8192
+#define SPECTRUM_SIZE   800     /* Bins of spectrum_data(), display width */
+
+#define SPECTRUM_NFFT_MIN   1024
+#define SPECTRUM_NFFT_MAX   4096
 
 void dsp_init(uint8_t factor);
+
+/**
+ * Queue IQ block for processing on DSP thread. Never blocks,
+ * blocks are dropped (and counted) if DSP thread falls behind
+ */
 void dsp_samples(float complex *buf_samples, uint16_t size, bool tx);
 void dsp_reset();
+uint32_t dsp_get_overruns();
+
+/**
+ * Number of IQ blocks waiting for DSP thread
+ */
+size_t dsp_get_queued();
 
 void dsp_set_spectrum_factor(uint8_t x);
+void dsp_set_fps(uint8_t spectrum_fps, uint8_t waterfall_fps);
+
+/**
+ * FFT size of waterfall (power of two, WATERFALL_NFFT..MAX). With waterfall
+ * zoom it runs on decimated stream of the shown spectrum level. Applied on
+ * DSP thread before next block
+ */
+void dsp_set_waterfall_nfft(uint16_t nfft);
+
+/**
+ * FFT size of zoomed spectrum (power of two, SPECTRUM_NFFT_MIN..MAX),
+ * remapped to SPECTRUM_SIZE. Applied on DSP thread before next block
+ */
+void dsp_set_spectrum_nfft(uint16_t nfft);
 
 float dsp_get_spectrum_beta();
 void dsp_set_spectrum_beta(float x);
 
+/**
+ * Averaging time constant of spectrum, from beta
+ */
+float dsp_get_spectrum_avg_ms();
+
+/**
+ * Move peak/min traces after frequency change, bins in spectrum_data() order
+ */
+void dsp_spectrum_shift(int16_t bins);
+
+/**
+ * Restart spectrum traces from next frame
+ */
+void dsp_spectrum_clear();
+
 void dsp_put_audio_samples(size_t nsamples, int16_t *samples);
@@ -0,0 +1,109 @@
+/*
+ *  SPDX-License-Identifier: LGPL-2.1-or-later
+ *
+ *  Xiegu X6100 LVGL GUI
+ *
+ *  Copyright (c) 2024 Georgy Dyuldin aka R2RFE
+ */
+
+#include "binmap.h"
+
+#include <math.h>
+#include <stdlib.h>
+
+typedef struct {
+    uint16_t    from;
+    uint16_t    count;      /* 0 - interpolate from and from + 1 */
+    float       frac;
+} binmap_item_t;
+
+struct binmap_s {
+    uint16_t        from_size;
+    uint16_t        to_size;
+    binmap_item_t   *items;
+};
+
+binmap_t binmap_create(uint16_t from_size, uint16_t to_size) {
+    binmap_t    m = (binmap_t) malloc(sizeof(struct binmap_s));
+    float       ratio = (float) from_size / to_size;
+
+    m->from_size = from_size;
+    m->to_size = to_size;
+    m->items = malloc(to_size * sizeof(binmap_item_t));
+
+    for (uint16_t i = 0; i < to_size; i++) {
+        binmap_item_t   *item = &m->items[i];
+
+        /* Centers: source bin from_size / 2 is output bin to_size / 2 */
+        float           center = (i - to_size / 2) * ratio + from_size / 2;
+        int32_t         lo = ceilf(center - ratio * 0.5f);
+        int32_t         hi = ceilf(center + ratio * 0.5f);
+
+        if (lo < 0) {
+            lo = 0;
+        }
+        if (hi > from_size) {
+            hi = from_size;
+        }
+
+        if (ratio > 1.0f && hi > lo) {
+            item->from = lo;
+            item->count = hi - lo;
+            item->frac = 0.0f;
+        } else {
+            int32_t from = floorf(center);
+
+            if (from < 0) {
+                from = 0;
+            } else if (from > from_size - 2) {
+                from = from_size - 2;
+            }
+
+            item->from = from;
+            item->count = 0;
+            item->frac = fminf(fmaxf(center - from, 0.0f), 1.0f);
+        }
+    }
+
+    return m;
+}
+
+void binmap_destroy(binmap_t m) {
+    free(m->items);
+    free(m);
+}
+
+uint16_t binmap_from_size(binmap_t m) {
+    return m->from_size;
+}
+
+uint16_t binmap_to_size(binmap_t m) {
+    return m->to_size;
+}
+
+void binmap_execute(binmap_t m, const float *x, float *y, binmap_mode_t mode) {
+    for (uint16_t i = 0; i < m->to_size; i++) {
+        const binmap_item_t *item = &m->items[i];
+        const float         *src = &x[item->from];
+
+        if (item->count == 0) {
+            y[i] = src[0] + (src[1] - src[0]) * item->frac;
+        } else if (mode == BINMAP_MAX) {
+            float v = src[0];
+
+            for (uint16_t n = 1; n < item->count; n++) {
+                if (src[n] > v) {
+                    v = src[n];
+                }
+            }
+            y[i] = v;
+        } else {
+            float v = 0.0f;
+
+            for (uint16_t n = 0; n < item->count; n++) {
+                v += src[n];
+            }
+            y[i] = v / item->count;
+        }
+    }
+}
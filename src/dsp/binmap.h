@@ -0,0 +1,37 @@
+/*
+ *  SPDX-License-Identifier: LGPL-2.1-or-later
+ *
+ *  Xiegu X6100 LVGL GUI
+ *
+ *  Copyright (c) 2024 Georgy Dyuldin aka R2RFE
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+/**
+ * Remapping of PSD bins to another number of bins (display pixels) over
+ * the same span, centers are aligned. Table is precomputed on create.
+ *
+ * When reducing, each output bin takes max or mean of source bins whose
+ * centers fall into it. When expanding, neighbour source bins are
+ * interpolated.
+ */
+typedef struct binmap_s * binmap_t;
+
+typedef enum {
+    BINMAP_MAX = 0,
+    BINMAP_MEAN
+} binmap_mode_t;
+
+binmap_t binmap_create(uint16_t from_size, uint16_t to_size);
+void binmap_destroy(binmap_t m);
+
+uint16_t binmap_from_size(binmap_t m);
+uint16_t binmap_to_size(binmap_t m);
+
+/**
+ * x - from_size bins, y - to_size bins
+ */
+void binmap_execute(binmap_t m, const float *x, float *y, binmap_mode_t mode);
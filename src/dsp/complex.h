@@ -0,0 +1,19 @@
+/*
+ *  SPDX-License-Identifier: LGPL-2.1-or-later
+ *
+ *  Xiegu X6100 LVGL GUI
+ *
+ *  Copyright (c) 2024 Georgy Dyuldin aka R2RFE
+ */
+
+#pragma once
+
+/* Complex type compatible with C and C++ (for tests), same way as liquid_float_complex */
+
+#ifdef __cplusplus
+#include <complex>
+typedef std::complex<float> dsp_complex_t;
+#else
+#include <complex.h>
+typedef float complex dsp_complex_t;
+#endif
@@ -0,0 +1,120 @@
+/*
+ *  SPDX-License-Identifier: LGPL-2.1-or-later
+ *
+ *  Xiegu X6100 LVGL GUI
+ *
+ *  Copyright (c) 2024 Georgy Dyuldin aka R2RFE
+ */
+
+#include "halfband.h"
+#include "kaiser.h"
+
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#define TRANSITION  0.1f        /* Relative to input rate */
+
+struct halfband_s {
+    uint16_t        m;          /* Number of non zero side taps on each side */
+    float           *h;         /* Side taps, h[0] is the nearest to center */
+    float           center;
+
+    float complex   *buf;       /* Delay line, 2 * len */
+    uint16_t        len;
+    uint16_t        pos;
+};
+
+halfband_t halfband_create(float as) {
+    halfband_t q = (halfband_t) malloc(sizeof(struct halfband_s));
+
+    /* Kaiser estimation of length, then round up to 4 * m - 1 */
+    float   n = (as - 7.95f) / (14.36f * TRANSITION) + 1.0f;
+    float   beta = kaiser_beta(as);
+
+    q->m = (uint16_t) ceilf((n + 1.0f) / 4.0f);
+
+    if (q->m < 1) {
+        q->m = 1;
+    }
+
+    q->len = 4 * q->m - 1;
+    q->h = malloc(q->m * sizeof(float));
+    q->center = 0.5f;
+
+    float half = (q->len - 1) / 2.0f;
+
+    for (uint16_t i = 0; i < q->m; i++) {
+        float t = 2 * i + 1;
+        float w = kaiser(t / half, beta);
+
+        q->h[i] = sinf(M_PI * t / 2.0f) / (M_PI * t) * w;
+    }
+
+    q->buf = malloc(2 * q->len * sizeof(float complex));
+    halfband_reset(q);
+
+    return q;
+}
+
+void halfband_destroy(halfband_t q) {
+    free(q->h);
+    free(q->buf);
+    free(q);
+}
+
+void halfband_reset(halfband_t q) {
+    memset(q->buf, 0, 2 * q->len * sizeof(float complex));
+    q->pos = 0;
+}
+
+void halfband_set_scale(halfband_t q, float scale) {
+    float k = scale / (2.0f * q->center);
+
+    for (uint16_t i = 0; i < q->m; i++) {
+        q->h[i] *= k;
+    }
+    q->center *= k;
+}
+
+size_t halfband_get_len(halfband_t q) {
+    return q->len;
+}
+
+static inline void push(halfband_t q, float complex x) {
+    /* Mirrored delay line, so window is always contiguous */
+    q->buf[q->pos] = x;
+    q->buf[q->pos + q->len] = x;
+
+    q->pos++;
+
+    if (q->pos == q->len) {
+        q->pos = 0;
+    }
+}
+
+void halfband_execute(halfband_t q, const float complex *x, size_t n, float complex *y) {
+    const uint16_t  mid = q->len / 2;
+    const uint16_t  m = q->m;
+    const float     *h = q->h;
+    const float     center = q->center;
+
+    for (size_t i = 0; i < n; i += 2) {
+        push(q, x[i]);
+        push(q, x[i + 1]);
+
+        /* Oldest sample first */
+        const float complex *w = &q->buf[q->pos];
+        float               re = crealf(w[mid]) * center;
+        float               im = cimagf(w[mid]) * center;
+
+        for (uint16_t k = 0; k < m; k++) {
+            float complex s = w[mid - 1 - 2 * k] + w[mid + 1 + 2 * k];
+
+            re += crealf(s) * h[k];
+            im += cimagf(s) * h[k];
+        }
+
+        y[i / 2] = re + im * I;
+    }
+}
@@ -0,0 +1,38 @@
+/*
+ *  SPDX-License-Identifier: LGPL-2.1-or-later
+ *
+ *  Xiegu X6100 LVGL GUI
+ *
+ *  Copyright (c) 2024 Georgy Dyuldin aka R2RFE
+ */
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include "complex.h"
+
+/**
+ * Half-band decimator by 2.
+ *
+ * Kaiser windowed half-band FIR: every second tap is zero and the filter
+ * is symmetric, so each output costs (taps + 1) / 4 multiplications per
+ * I/Q component. Passband is up to 0.2 of input rate, stopband from 0.3
+ */
+typedef struct halfband_s * halfband_t;
+
+halfband_t halfband_create(float as);
+void halfband_destroy(halfband_t q);
+void halfband_reset(halfband_t q);
+
+/**
+ * Set output gain (1.0 - unity DC gain)
+ */
+void halfband_set_scale(halfband_t q, float scale);
+
+size_t halfband_get_len(halfband_t q);
+
+/**
+ * Decimate n input samples (n is even) to n / 2 output samples
+ */
+void halfband_execute(halfband_t q, const dsp_complex_t *x, size_t n, dsp_complex_t *y);
@@ -0,0 +1,104 @@
+/*
+ *  SPDX-License-Identifier: LGPL-2.1-or-later
+ *
+ *  Xiegu X6100 LVGL GUI
+ *
+ *  Copyright (c) 2024 Georgy Dyuldin aka R2RFE
+ */
+
+#include "hilbert.h"
+#include "kaiser.h"
+
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#define CHUNK   256     /* Output samples per pass */
+
+struct hilbert_s {
+    uint8_t     m;
+    float       *h;     /* Odd taps, h[k] is at distance 2 * k + 1 from center */
+    float       *buf;   /* History of 4 * m samples, then CHUNK new ones */
+    float       *im;
+};
+
+hilbert_t hilbert_create(uint8_t m, float as) {
+    hilbert_t q = (hilbert_t) malloc(sizeof(struct hilbert_s));
+
+    if (m < 1) {
+        m = 1;
+    }
+
+    q->m = m;
+    q->h = malloc(m * sizeof(float));
+    q->buf = malloc((4 * m + CHUNK) * sizeof(float));
+    q->im = malloc(CHUNK * sizeof(float));
+
+    float beta = kaiser_beta(as);
+    float half = 2 * m;
+
+    for (uint8_t k = 0; k < m; k++) {
+        float t = 2 * k + 1;
+
+        q->h[k] = 2.0f / (M_PI * t) * kaiser(t / half, beta);
+    }
+
+    hilbert_reset(q);
+
+    return q;
+}
+
+void hilbert_destroy(hilbert_t q) {
+    free(q->h);
+    free(q->buf);
+    free(q->im);
+    free(q);
+}
+
+void hilbert_reset(hilbert_t q) {
+    memset(q->buf, 0, 4 * q->m * sizeof(float));
+}
+
+size_t hilbert_get_delay(hilbert_t q) {
+    return 2 * q->m;
+}
+
+static void execute_chunk(hilbert_t q, size_t n, float complex *y) {
+    const uint16_t  mid = 2 * q->m;
+    const float     *buf = q->buf;
+    float           *im = q->im;
+
+    memset(im, 0, n * sizeof(float));
+
+    /* Tap by tap, inner loop over samples is contiguous */
+    for (uint8_t k = 0; k < q->m; k++) {
+        const float h = q->h[k];
+        const float *older = &buf[mid - 1 - 2 * k];
+        const float *newer = &buf[mid + 1 + 2 * k];
+
+        for (size_t i = 0; i < n; i++) {
+            im[i] += h * (older[i] - newer[i]);
+        }
+    }
+
+    for (size_t i = 0; i < n; i++) {
+        y[i] = buf[mid + i] + im[i] * I;
+    }
+
+    memmove(q->buf, &q->buf[n], 4 * q->m * sizeof(float));
+}
+
+void hilbert_execute(hilbert_t q, const float *x, size_t n, float complex *y) {
+    const size_t hist = 4 * q->m;
+
+    while (n) {
+        size_t part = n < CHUNK ? n : CHUNK;
+
+        memcpy(&q->buf[hist], x, part * sizeof(float));
+        execute_chunk(q, part, y);
+
+        x += part;
+        y += part;
+        n -= part;
+    }
+}
@@ -0,0 +1,38 @@
+/*
+ *  SPDX-License-Identifier: LGPL-2.1-or-later
+ *
+ *  Xiegu X6100 LVGL GUI
+ *
+ *  Copyright (c) 2024 Georgy Dyuldin aka R2RFE
+ */
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include "complex.h"
+
+/**
+ * Real to analytic signal converter.
+ *
+ * Kaiser windowed FIR Hilbert transformer of length 4 * m + 1. Even taps
+ * are zero and odd ones are antisymmetric, so the imaginary part costs m
+ * multiplications per sample and the real part is just input delayed by
+ * 2 * m. Samples are processed by blocks on a linear history buffer,
+ * which lets the compiler vectorize over output samples.
+ */
+typedef struct hilbert_s * hilbert_t;
+
+hilbert_t hilbert_create(uint8_t m, float as);
+void hilbert_destroy(hilbert_t q);
+void hilbert_reset(hilbert_t q);
+
+/**
+ * Group delay, samples
+ */
+size_t hilbert_get_delay(hilbert_t q);
+
+/**
+ * Convert n real samples, cos(wt) becomes exp(jwt)
+ */
+void hilbert_execute(hilbert_t q, const float *x, size_t n, dsp_complex_t *y);
@@ -0,0 +1,276 @@
+/*
+ *  SPDX-License-Identifier: LGPL-2.1-or-later
+ *
+ *  Xiegu X6100 LVGL GUI
+ *
+ *  Copyright (c) 2024 Georgy Dyuldin aka R2RFE
+ */
+
+#include "iqfile.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define MAGIC       0x51493658  /* "X6IQ" */
+#define WRITE_BUF   (256 * 1024)
+#define INDEX_BUF   (16 * 1024)
+
+typedef struct __attribute__((packed)) {
+    uint32_t    magic;
+    uint16_t    flags;
+    uint16_t    count;
+    uint64_t    time_us;
+} header_t;
+
+/* TX part of recording, in samples */
+typedef struct {
+    uint64_t        start;
+    uint64_t        count;
+} segment_t;
+
+struct iqfile_s {
+    FILE            *data;
+    FILE            *index;
+    char            *buf;
+    char            *index_buf;
+    char            *meta_path;
+    iqfile_meta_t   meta;
+    char            datetime[32];
+    size_t          packets;
+    uint64_t        samples;
+
+    segment_t       *tx;
+    size_t          tx_count;
+    bool            tx_on;
+};
+
+static void write_json_str(FILE *f, const char *str) {
+    fputc('"', f);
+
+    for (; str && *str; str++) {
+        if (*str == '"' || *str == '\\') {
+            fputc('\\', f);
+            fputc(*str, f);
+        } else if ((unsigned char) *str >= 0x20) {
+            fputc(*str, f);
+        }
+    }
+    fputc('"', f);
+}
+
+static void add_tx(iqfile_t f, bool tx, uint16_t count) {
+    if (tx && !f->tx_on) {
+        f->tx = realloc(f->tx, (f->tx_count + 1) * sizeof(segment_t));
+        f->tx[f->tx_count].start = f->samples;
+        f->tx[f->tx_count].count = 0;
+        f->tx_count++;
+    }
+
+    if (tx) {
+        f->tx[f->tx_count - 1].count += count;
+    }
+
+    f->tx_on = tx;
+}
+
+static bool write_meta(iqfile_t f) {
+    FILE *meta = fopen(f->meta_path, "w");
+
+    if (!meta) {
+        return false;
+    }
+
+    fprintf(meta, "{\n  \"global\": {\n");
+    fprintf(meta, "    \"core:datatype\": \"cf32_le\",\n");
+    fprintf(meta, "    \"core:sample_rate\": %u,\n", f->meta.sample_rate);
+    fprintf(meta, "    \"core:version\": \"1.0.0\",\n");
+    fprintf(meta, "    \"core:recorder\": \"x6100_gui\",\n");
+    fprintf(meta, "    \"core:description\": ");
+    write_json_str(meta, f->meta.description);
+    fprintf(meta, ",\n");
+    fprintf(meta, "    \"x6100:index\": \"" IQFILE_INDEX_EXT "\",\n");
+    fprintf(meta, "    \"x6100:index_format\": \"u32 magic, u16 flags, u16 count, u64 time_us\",\n");
+    fprintf(meta, "    \"x6100:flags\": { \"tx\": %u },\n", IQFILE_FLAG_TX);
+    fprintf(meta, "    \"x6100:packets\": %zu\n", f->packets);
+    fprintf(meta, "  },\n  \"captures\": [\n    {\n");
+    fprintf(meta, "      \"core:sample_start\": 0,\n");
+    fprintf(meta, "      \"core:frequency\": %llu,\n", (unsigned long long) f->meta.frequency);
+    fprintf(meta, "      \"core:datetime\": \"%s\"\n", f->datetime);
+    fprintf(meta, "    }\n  ],\n  \"annotations\": [");
+
+    for (size_t i = 0; i < f->tx_count; i++) {
+        fprintf(meta, "%s\n    {\n", i ? "," : "");
+        fprintf(meta, "      \"core:sample_start\": %llu,\n", (unsigned long long) f->tx[i].start);
+        fprintf(meta, "      \"core:sample_count\": %llu,\n", (unsigned long long) f->tx[i].count);
+        fprintf(meta, "      \"core:label\": \"TX\"\n");
+        fprintf(meta, "    }");
+    }
+
+    fprintf(meta, "%s]\n}\n", f->tx_count ? "\n  " : "");
+
+    return fclose(meta) == 0;
+}
+
+static char * path_ext(const char *path, const char *ext) {
+    size_t  len = strlen(path) + strlen(ext) + 1;
+    char    *res = malloc(len);
+
+    snprintf(res, len, "%s%s", path, ext);
+    return res;
+}
+
+/**
+ * Index is named as data file with other extension
+ */
+static FILE * open_index(const char *path, const char *mode) {
+    size_t  len = strlen(path);
+    size_t  ext_len = strlen(IQFILE_DATA_EXT);
+
+    if (len >= ext_len && strcmp(path + len - ext_len, IQFILE_DATA_EXT) == 0) {
+        len -= ext_len;
+    }
+
+    char *index_path = malloc(len + strlen(IQFILE_INDEX_EXT) + 1);
+
+    memcpy(index_path, path, len);
+    strcpy(index_path + len, IQFILE_INDEX_EXT);
+
+    FILE *index = fopen(index_path, mode);
+
+    free(index_path);
+    return index;
+}
+
+iqfile_t iqfile_create(const char *path, const iqfile_meta_t *meta) {
+    char    *data_path = path_ext(path, IQFILE_DATA_EXT);
+    FILE    *data = fopen(data_path, "wb");
+
+    free(data_path);
+
+    if (!data) {
+        return NULL;
+    }
+
+    FILE *index = open_index(path, "wb");
+
+    if (!index) {
+        fclose(data);
+        return NULL;
+    }
+
+    iqfile_t f = (iqfile_t) calloc(1, sizeof(struct iqfile_s));
+
+    f->data = data;
+    f->index = index;
+    f->buf = malloc(WRITE_BUF);
+    f->index_buf = malloc(INDEX_BUF);
+    f->meta_path = path_ext(path, IQFILE_META_EXT);
+    f->meta = *meta;
+    f->meta.description = meta->description ? strdup(meta->description) : NULL;
+
+    setvbuf(f->data, f->buf, _IOFBF, WRITE_BUF);
+    setvbuf(f->index, f->index_buf, _IOFBF, INDEX_BUF);
+
+    time_t      now = time(NULL);
+    struct tm   t;
+
+    gmtime_r(&now, &t);
+    strftime(f->datetime, sizeof(f->datetime), "%Y-%m-%dT%H:%M:%SZ", &t);
+
+    if (!write_meta(f)) {
+        iqfile_close(f);
+        return NULL;
+    }
+
+    return f;
+}
+
+iqfile_t iqfile_open(const char *path) {
+    FILE *data = fopen(path, "rb");
+
+    if (!data) {
+        return NULL;
+    }
+
+    FILE *index = open_index(path, "rb");
+
+    if (!index) {
+        fclose(data);
+        return NULL;
+    }
+
+    iqfile_t f = (iqfile_t) calloc(1, sizeof(struct iqfile_s));
+
+    f->data = data;
+    f->index = index;
+
+    return f;
+}
+
+void iqfile_close(iqfile_t f) {
+    fclose(f->data);
+    fclose(f->index);
+
+    if (f->meta_path) {
+        write_meta(f);
+        free(f->meta_path);
+    }
+
+    free((char *) f->meta.description);
+    free(f->buf);
+    free(f->index_buf);
+    free(f->tx);
+    free(f);
+}
+
+bool iqfile_write(iqfile_t f, const iqfile_packet_t *packet, const dsp_complex_t *samples) {
+    header_t header = {
+        .magic = MAGIC,
+        .flags = packet->flags,
+        .count = packet->count,
+        .time_us = packet->time_us
+    };
+
+    if (fwrite(samples, sizeof(dsp_complex_t), packet->count, f->data) != packet->count) {
+        return false;
+    }
+
+    if (fwrite(&header, sizeof(header), 1, f->index) != 1) {
+        return false;
+    }
+
+    add_tx(f, packet->flags & IQFILE_FLAG_TX, packet->count);
+
+    f->packets++;
+    f->samples += packet->count;
+    return true;
+}
+
+bool iqfile_read(iqfile_t f, iqfile_packet_t *packet, dsp_complex_t *samples, uint16_t max_count) {
+    header_t header;
+
+    if (fread(&header, sizeof(header), 1, f->index) != 1) {
+        return false;
+    }
+
+    if (header.magic != MAGIC || header.count > max_count) {
+        return false;
+    }
+
+    if (fread(samples, sizeof(dsp_complex_t), header.count, f->data) != header.count) {
+        return false;
+    }
+
+    packet->time_us = header.time_us;
+    packet->flags = header.flags;
+    packet->count = header.count;
+
+    f->packets++;
+    return true;
+}
+
+size_t iqfile_packets(iqfile_t f) {
+    return f->packets;
+}
@@ -0,0 +1,68 @@
+/*
+ *  SPDX-License-Identifier: LGPL-2.1-or-later
+ *
+ *  Xiegu X6100 LVGL GUI
+ *
+ *  Copyright (c) 2024 Georgy Dyuldin aka R2RFE
+ */
+
+#pragma once
+
+#include "complex.h"
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#define IQFILE_DATA_EXT     ".sigmf-data"
+#define IQFILE_META_EXT     ".sigmf-meta"
+#define IQFILE_INDEX_EXT    ".x6100-index"
+
+#define IQFILE_FLAG_TX  (1 << 0)
+
+/**
+ * IQ recording: SigMF data file with plain cf32_le samples, SigMF meta
+ * (rate, frequency, TX segments as annotations) and packet index.
+ *
+ * Index has a 16 byte header per packet: magic, flags, count and capture
+ * time. Packets follow each other in the data file without gaps.
+ */
+typedef struct {
+    uint64_t    time_us;    /* Monotonic capture time */
+    uint16_t    flags;      /* IQFILE_FLAG_* */
+    uint16_t    count;      /* Number of complex samples */
+} iqfile_packet_t;
+
+typedef struct {
+    uint32_t    sample_rate;
+    uint64_t    frequency;
+    const char  *description;
+} iqfile_meta_t;
+
+typedef struct iqfile_s * iqfile_t;
+
+/**
+ * Create recording. Path is without extension, data, meta and index files
+ * are created. Returns NULL on error
+ */
+iqfile_t iqfile_create(const char *path, const iqfile_meta_t *meta);
+
+/**
+ * Open data file for reading, index is found next to it. Returns NULL on
+ * error
+ */
+iqfile_t iqfile_open(const char *path);
+
+/**
+ * Close file. For recording, meta is updated with final packets count
+ */
+void iqfile_close(iqfile_t f);
+
+bool iqfile_write(iqfile_t f, const iqfile_packet_t *packet, const dsp_complex_t *samples);
+
+/**
+ * Read next packet. Returns false at the end of file or on broken packet
+ */
+bool iqfile_read(iqfile_t f, iqfile_packet_t *packet, dsp_complex_t *samples, uint16_t max_count);
+
+size_t iqfile_packets(iqfile_t f);
@@ -0,0 +1,49 @@
+/*
+ *  SPDX-License-Identifier: LGPL-2.1-or-later
+ *
+ *  Xiegu X6100 LVGL GUI
+ *
+ *  Copyright (c) 2024 Georgy Dyuldin aka R2RFE
+ */
+
+#pragma once
+
+#include <math.h>
+
+/**
+ * Kaiser window helpers for FIR design
+ */
+
+static inline float kaiser_i0(float x) {
+    float sum = 1.0f;
+    float term = 1.0f;
+
+    for (int k = 1; k < 32; k++) {
+        term *= (x / (2.0f * k)) * (x / (2.0f * k));
+        sum += term;
+
+        if (term < sum * 1e-9f) {
+            break;
+        }
+    }
+    return sum;
+}
+
+/**
+ * Window shape for stopband attenuation as (dB)
+ */
+static inline float kaiser_beta(float as) {
+    if (as > 50.0f) {
+        return 0.1102f * (as - 8.7f);
+    } else if (as > 21.0f) {
+        return 0.5842f * powf(as - 21.0f, 0.4f) + 0.07886f * (as - 21.0f);
+    }
+    return 0.0f;
+}
+
+/**
+ * Window value at r = -1 .. 1 from the center
+ */
+static inline float kaiser(float r, float beta) {
+    return kaiser_i0(beta * sqrtf(1.0f - r * r)) / kaiser_i0(beta);
+}
@@ -0,0 +1,131 @@
+/*
+ *  SPDX-License-Identifier: LGPL-2.1-or-later
+ *
+ *  Xiegu X6100 LVGL GUI
+ *
+ *  Copyright (c) 2024 Georgy Dyuldin aka R2RFE
+ */
+
+#include "palmap.h"
+
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#define SIZE    ((size_t) ((PALMAP_CEIL_DB - PALMAP_FLOOR_DB) / PALMAP_STEP_DB) + 1)
+
+struct palmap_s {
+    float       min;
+    float       max;
+
+    uint8_t     *index;     /* Quantized input to palette index */
+    uint32_t    *color;     /* Quantized input to color */
+    uint32_t    *palette;
+};
+
+static void build_color(palmap_t m) {
+    if (!m->palette) {
+        return;
+    }
+
+    for (size_t i = 0; i < SIZE; i++) {
+        m->color[i] = m->palette[m->index[i]];
+    }
+}
+
+static void build(palmap_t m) {
+    float k = 255.0f / (m->max - m->min);
+
+    for (size_t i = 0; i < SIZE; i++) {
+        float v = (PALMAP_FLOOR_DB + i * PALMAP_STEP_DB - m->min) * k;
+
+        if (v < 0.0f) {
+            v = 0.0f;
+        } else if (v > 255.0f) {
+            v = 255.0f;
+        }
+        m->index[i] = (uint8_t) v;
+    }
+
+    build_color(m);
+}
+
+palmap_t palmap_create(float min, float max) {
+    palmap_t m = (palmap_t) malloc(sizeof(struct palmap_s));
+
+    m->index = malloc(SIZE * sizeof(uint8_t));
+    m->color = malloc(SIZE * sizeof(uint32_t));
+    m->palette = NULL;
+    m->min = min;
+    m->max = max;
+
+    build(m);
+
+    return m;
+}
+
+void palmap_destroy(palmap_t m) {
+    free(m->index);
+    free(m->color);
+    free(m->palette);
+    free(m);
+}
+
+void palmap_set_palette(palmap_t m, const uint32_t *palette) {
+    if (!m->palette) {
+        m->palette = malloc(256 * sizeof(uint32_t));
+    }
+
+    memcpy(m->palette, palette, 256 * sizeof(uint32_t));
+    build_color(m);
+}
+
+bool palmap_set_range(palmap_t m, float min, float max) {
+    if (max - min < PALMAP_STEP_DB) {
+        max = min + PALMAP_STEP_DB;
+    }
+
+    if (fabsf(min - m->min) < PALMAP_STEP_DB && fabsf(max - m->max) < PALMAP_STEP_DB) {
+        return false;
+    }
+
+    m->min = min;
+    m->max = max;
+
+    build(m);
+
+    return true;
+}
+
+static inline size_t quantize(float x) {
+    float q = (x - PALMAP_FLOOR_DB) * (1.0f / PALMAP_STEP_DB) + 0.5f;
+
+    if (q < 0.0f) {
+        return 0;
+    } else if (q > SIZE - 1) {
+        return SIZE - 1;
+    }
+    return (size_t) q;
+}
+
+void palmap_execute_index(palmap_t m, const float *x, size_t n, uint8_t *y, bool reverse) {
+    const uint8_t *index = m->index;
+
+    if (reverse) {
+        for (size_t i = 0; i < n; i++) {
+            y[n - 1 - i] = index[quantize(x[i])];
+        }
+    } else {
+        for (size_t i = 0; i < n; i++) {
+            y[i] = index[quantize(x[i])];
+        }
+    }
+}
+
+void palmap_execute_color(palmap_t m, const float *x, size_t n, uint32_t *y) {
+    const uint32_t *color = m->color;
+
+    for (size_t i = 0; i < n; i++) {
+        y[i] = color[quantize(x[i])];
+    }
+}
@@ -0,0 +1,50 @@
+/*
+ *  SPDX-License-Identifier: LGPL-2.1-or-later
+ *
+ *  Xiegu X6100 LVGL GUI
+ *
+ *  Copyright (c) 2024 Georgy Dyuldin aka R2RFE
+ */
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#define PALMAP_FLOOR_DB     -200.0f
+#define PALMAP_CEIL_DB      40.0f
+#define PALMAP_STEP_DB      0.25f
+
+/**
+ * Mapping of dB values to palette for waterfalls.
+ *
+ * Input is quantized to PALMAP_STEP_DB, then a lookup table gives
+ * palette index or color directly. Tables are rebuilt only when min/max
+ * range is moved by a step or more, so slow auto range costs nothing
+ * per pixel.
+ */
+typedef struct palmap_s * palmap_t;
+
+palmap_t palmap_create(float min, float max);
+void palmap_destroy(palmap_t m);
+
+/**
+ * Palette of 256 colors, min maps to 0 and max to 255. Palette is copied
+ */
+void palmap_set_palette(palmap_t m, const uint32_t *palette);
+
+/**
+ * Return true if tables are rebuilt
+ */
+bool palmap_set_range(palmap_t m, float min, float max);
+
+/**
+ * Palette indexes, with reverse y[n - 1 - i] is written for x[i]
+ */
+void palmap_execute_index(palmap_t m, const float *x, size_t n, uint8_t *y, bool reverse);
+
+/**
+ * Colors, palette should be set
+ */
+void palmap_execute_color(palmap_t m, const float *x, size_t n, uint32_t *y);
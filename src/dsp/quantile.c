@@ -0,0 +1,110 @@
+/*
+ *  SPDX-License-Identifier: LGPL-2.1-or-later
+ *
+ *  Xiegu X6100 LVGL GUI
+ *
+ *  Copyright (c) 2024 Georgy Dyuldin aka R2RFE
+ */
+
+#include "quantile.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+struct quantile_s {
+    float       min;
+    float       step;
+    float       k;
+    uint16_t    bins;
+    uint32_t    *hist;
+    size_t      count;
+};
+
+quantile_t quantile_create(float min, float max, float step) {
+    quantile_t q = (quantile_t) malloc(sizeof(struct quantile_s));
+
+    q->min = min;
+    q->step = step;
+    q->k = 1.0f / step;
+    q->bins = (max - min) / step + 0.5f;
+
+    if (q->bins == 0) {
+        q->bins = 1;
+    }
+
+    q->hist = malloc(q->bins * sizeof(q->hist[0]));
+    quantile_reset(q);
+
+    return q;
+}
+
+void quantile_destroy(quantile_t q) {
+    free(q->hist);
+    free(q);
+}
+
+void quantile_reset(quantile_t q) {
+    memset(q->hist, 0, q->bins * sizeof(q->hist[0]));
+    q->count = 0;
+}
+
+void quantile_put(quantile_t q, const float *data, size_t n) {
+    const int32_t last = q->bins - 1;
+
+    for (size_t i = 0; i < n; i++) {
+        float   x = (data[i] - q->min) * q->k;
+        int32_t bin;
+
+        /* Clamp before cast, -inf and NaN of silent blocks go to bin 0 */
+        if (!(x > 0.0f)) {
+            bin = 0;
+        } else if (x >= last) {
+            bin = last;
+        } else {
+            bin = (int32_t) x;
+        }
+
+        q->hist[bin]++;
+    }
+    q->count += n;
+}
+
+size_t quantile_count(quantile_t q) {
+    return q->count;
+}
+
+float quantile_get_nth(quantile_t q, size_t nth) {
+    size_t sum = 0;
+
+    if (q->count == 0) {
+        return q->min;
+    }
+
+    if (nth >= q->count) {
+        nth = q->count - 1;
+    }
+
+    for (uint16_t i = 0; i < q->bins; i++) {
+        sum += q->hist[i];
+
+        if (sum > nth) {
+            return q->min + (i + 0.5f) * q->step;
+        }
+    }
+
+    return q->min + (q->bins - 0.5f) * q->step;
+}
+
+float quantile_get(quantile_t q, float rank) {
+    if (q->count == 0) {
+        return q->min;
+    }
+
+    if (rank < 0.0f) {
+        rank = 0.0f;
+    } else if (rank > 1.0f) {
+        rank = 1.0f;
+    }
+
+    return quantile_get_nth(q, (size_t) (rank * (q->count - 1) + 0.5f));
+}
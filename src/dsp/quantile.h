@@ -0,0 +1,39 @@
+/*
+ *  SPDX-License-Identifier: LGPL-2.1-or-later
+ *
+ *  Xiegu X6100 LVGL GUI
+ *
+ *  Copyright (c) 2024 Georgy Dyuldin aka R2RFE
+ */
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * Histogram based quantile estimator.
+ *
+ * Values are accumulated into fixed step bins within [min, max), values
+ * outside the range are clamped to the edge bins. Input data is never
+ * modified. Cost is O(n) for put and O(bins) for get, result precision is
+ * one bin step.
+ */
+typedef struct quantile_s * quantile_t;
+
+quantile_t quantile_create(float min, float max, float step);
+void quantile_destroy(quantile_t q);
+
+void quantile_reset(quantile_t q);
+void quantile_put(quantile_t q, const float *data, size_t n);
+size_t quantile_count(quantile_t q);
+
+/**
+ * Value of nth smallest item (0 - minimum)
+ */
+float quantile_get_nth(quantile_t q, size_t nth);
+
+/**
+ * Value at rank (0.0 - minimum, 0.5 - median, 1.0 - maximum)
+ */
+float quantile_get(quantile_t q, float rank);
@@ -0,0 +1,99 @@
+/*
+ *  SPDX-License-Identifier: LGPL-2.1-or-later
+ *
+ *  Xiegu X6100 LVGL GUI
+ *
+ *  Copyright (c) 2024 Georgy Dyuldin aka R2RFE
+ */
+
+#include "smeter.h"
+
+#include <math.h>
+#include <stdbool.h>
+#include <stdlib.h>
+
+#define DB_TO_LOG2  0.33219281f     /* log2(10) / 10 */
+#define LOG2_TO_DB  3.01029996f     /* 10 / log2(10) */
+
+struct smeter_s {
+    float   attack_ms;
+    float   decay_ms;
+    float   db;
+    bool    empty;
+};
+
+smeter_t smeter_create() {
+    smeter_t m = (smeter_t) malloc(sizeof(struct smeter_s));
+
+    m->attack_ms = 0.0f;
+    m->decay_ms = 0.0f;
+    m->empty = true;
+
+    return m;
+}
+
+void smeter_destroy(smeter_t m) {
+    free(m);
+}
+
+void smeter_set_ballistics(smeter_t m, float attack_ms, float decay_ms) {
+    m->attack_ms = attack_ms;
+    m->decay_ms = decay_ms;
+}
+
+void smeter_reset(smeter_t m) {
+    m->empty = true;
+}
+
+float smeter_put(smeter_t m, float db, float dt_ms) {
+    if (m->empty) {
+        m->db = db;
+        m->empty = false;
+        return db;
+    }
+
+    float tau = (db > m->db) ? m->attack_ms : m->decay_ms;
+    float alpha = (tau > 0.0f) ? 1.0f - expf(-dt_ms / tau) : 1.0f;
+
+    m->db += alpha * (db - m->db);
+
+    return m->db;
+}
+
+/**
+ * 2^x within 0.01 dB, enough for a meter and much cheaper than powf
+ */
+static inline float fast_exp2(float x) {
+    if (x < -126.0f) {
+        return 0.0f;
+    }
+
+    float   xi = floorf(x);
+    float   f = x - xi;
+    float   p = 1.0f + f * (0.69583356f + f * (0.22606716f + f * 0.07944023f));
+
+    union { float f; uint32_t i; } v = { .f = p };
+
+    v.i += (uint32_t) ((int32_t) xi + 127) << 23;
+    v.i -= 127u << 23;
+
+    return v.f;
+}
+
+float smeter_channel_power(const float *psd, uint16_t from, uint16_t to, float enbw) {
+    float sum = 0.0f;
+
+    for (uint16_t i = from; i <= to; i++) {
+        sum += fast_exp2(psd[i] * DB_TO_LOG2);
+    }
+
+    if (sum <= 0.0f) {
+        return -200.0f;
+    }
+
+    return LOG2_TO_DB * log2f(sum / enbw);
+}
+
+float smeter_bandwidth_db(uint16_t n, float enbw) {
+    return 10.0f * log10f(n / enbw);
+}
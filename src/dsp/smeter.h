@@ -0,0 +1,50 @@
+/*
+ *  SPDX-License-Identifier: LGPL-2.1-or-later
+ *
+ *  Xiegu X6100 LVGL GUI
+ *
+ *  Copyright (c) 2024 Georgy Dyuldin aka R2RFE
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+/**
+ * S-meter: channel power from PSD bins with attack/decay ballistics.
+ *
+ * Power is integrated in linear domain over the passband bins and
+ * corrected by equivalent noise bandwidth of the FFT window, so a carrier
+ * reads the same as its peak bin and does not depend on FFT size, while
+ * wide signals and noise read their full channel power.
+ */
+typedef struct smeter_s * smeter_t;
+
+smeter_t smeter_create();
+void smeter_destroy(smeter_t m);
+
+/**
+ * Time constants of the rise and fall of the reading, 0 - no smoothing
+ */
+void smeter_set_ballistics(smeter_t m, float attack_ms, float decay_ms);
+
+/**
+ * Put channel power in dB, dt_ms - time since previous put. Returns reading
+ */
+float smeter_put(smeter_t m, float db, float dt_ms);
+
+/**
+ * Next put sets the reading without smoothing
+ */
+void smeter_reset(smeter_t m);
+
+/**
+ * Power of bins from..to (inclusive) in dB, enbw - window equivalent noise
+ * bandwidth in bins (1.5 for Hann)
+ */
+float smeter_channel_power(const float *psd, uint16_t from, uint16_t to, float enbw);
+
+/**
+ * Correction from per-bin level (noise floor) to channel power of n bins
+ */
+float smeter_bandwidth_db(uint16_t n, float enbw);
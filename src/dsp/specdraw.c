@@ -0,0 +1,175 @@
+/*
+ *  SPDX-License-Identifier: LGPL-2.1-or-later
+ *
+ *  Xiegu X6100 LVGL GUI
+ *
+ *  Copyright (c) 2024 Georgy Dyuldin aka R2RFE
+ */
+
+#include "specdraw.h"
+
+#include <stdbool.h>
+
+typedef struct {
+    const specdraw_canvas_t *c;
+    uint32_t                color;
+    uint32_t                rb;     /* Premultiplied color channels */
+    uint32_t                g;
+    uint32_t                inv;    /* 256 - alpha */
+    bool                    blend;
+} pen_t;
+
+static inline int32_t value_y(const specdraw_area_t *a, float k, float v) {
+    float y = a->y + (a->max - v) * k;
+
+    /* Keep far values in int range, they are clipped anyway */
+
+    if (y < a->y - a->h) {
+        y = a->y - a->h;
+    } else if (y > a->y + 2 * a->h) {
+        y = a->y + 2 * a->h;
+    }
+
+    return (int32_t) y;
+}
+
+static inline int32_t column_x(const specdraw_area_t *a, uint16_t n, uint32_t i) {
+    return a->x + (int32_t) (i * a->w / n);
+}
+
+static void span(const pen_t *p, int32_t x, int32_t y1, int32_t y2) {
+    const specdraw_canvas_t *c = p->c;
+
+    if (x < c->clip_x1 || x > c->clip_x2) {
+        return;
+    }
+
+    if (y1 < c->clip_y1) {
+        y1 = c->clip_y1;
+    }
+
+    if (y2 > c->clip_y2) {
+        y2 = c->clip_y2;
+    }
+
+    if (y1 > y2) {
+        return;
+    }
+
+    uint32_t    *px = c->buf + (y1 - c->buf_y) * c->stride + (x - c->buf_x);
+    int32_t     count = y2 - y1 + 1;
+
+    if (!p->blend) {
+        for (int32_t i = 0; i < count; i++, px += c->stride) {
+            *px = p->color;
+        }
+    } else {
+        for (int32_t i = 0; i < count; i++, px += c->stride) {
+            uint32_t d = *px;
+            uint32_t rb = (((d & 0xFF00FF) * p->inv + p->rb) >> 8) & 0xFF00FF;
+            uint32_t g = (((d & 0x00FF00) * p->inv + p->g) >> 8) & 0x00FF00;
+
+            *px = (d & 0xFF000000) | rb | g;
+        }
+    }
+}
+
+static void filled(const pen_t *p, const specdraw_area_t *a, const float *v, uint16_t n, float k) {
+    int32_t     bottom = a->y + a->h;
+    uint16_t    i = 0;
+
+    while (i < n) {
+        int32_t x = column_x(a, n, i);
+        int32_t top = value_y(a, k, v[i]);
+
+        /* Values on the same column, the highest one is drawn */
+
+        while (++i < n && column_x(a, n, i) == x) {
+            int32_t y = value_y(a, k, v[i]);
+
+            if (y < top) {
+                top = y;
+            }
+        }
+
+        /* Column is repeated till the next value */
+
+        for (int32_t next = column_x(a, n, i); x < next; x++) {
+            span(p, x, top, bottom);
+        }
+    }
+}
+
+static void line(const pen_t *p, const specdraw_area_t *a, const float *v, uint16_t n, float k) {
+    int32_t x = column_x(a, n, 0);
+    int32_t y = value_y(a, k, v[0]);
+    int32_t lo = y;
+    int32_t hi = y;
+
+    for (uint16_t i = 1; i < n; i++) {
+        int32_t next_x = column_x(a, n, i);
+        int32_t next_y = value_y(a, k, v[i]);
+
+        if (next_x == x) {
+            if (next_y < lo) lo = next_y;
+            if (next_y > hi) hi = next_y;
+
+            y = next_y;
+            continue;
+        }
+
+        /* Each column joins the previous one without overlap */
+
+        int32_t from_x = x;
+        int32_t from_y = y;
+
+        for (int32_t c = from_x + 1; c <= next_x; c++) {
+            int32_t cy = from_y + (next_y - from_y) * (c - from_x) / (next_x - from_x);
+
+            span(p, x, lo, hi);
+
+            if (cy > y) {
+                lo = y + 1;
+                hi = cy;
+            } else if (cy < y) {
+                lo = cy;
+                hi = y - 1;
+            } else {
+                lo = hi = cy;
+            }
+
+            x = c;
+            y = cy;
+        }
+    }
+
+    span(p, x, lo, hi);
+}
+
+void specdraw_trace(const specdraw_canvas_t *c, const specdraw_area_t *a, const float *v, uint16_t n,
+                    specdraw_mode_t mode, uint32_t color, uint8_t opa) {
+    if (n == 0 || opa == 0 || a->w <= 0 || a->max <= a->min) {
+        return;
+    }
+
+    pen_t   p = { .c = c, .color = color | 0xFF000000, .blend = opa < 255 };
+    float   k = a->h / (a->max - a->min);
+
+    if (p.blend) {
+        uint32_t alpha = opa + (opa >> 7);
+
+        p.rb = (color & 0xFF00FF) * alpha;
+        p.g = (color & 0x00FF00) * alpha;
+        p.inv = 256 - alpha;
+    }
+
+    switch (mode) {
+        case SPECDRAW_FILLED:
+            filled(&p, a, v, n, k);
+            break;
+
+        case SPECDRAW_LINE:
+            line(&p, a, v, n, k);
+            break;
+    }
+}
@@ -0,0 +1,52 @@
+/*
+ *  SPDX-License-Identifier: LGPL-2.1-or-later
+ *
+ *  Xiegu X6100 LVGL GUI
+ *
+ *  Copyright (c) 2024 Georgy Dyuldin aka R2RFE
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+/**
+ * Spectrum trace rasterizer.
+ *
+ * A trace is drawn by vertical spans, one per pixel column, written
+ * directly into 32 bit pixel buffer with optional alpha blending. Spans
+ * are clipped to the clip area, so it is safe to pass values out of
+ * min..max range.
+ */
+
+typedef enum {
+    SPECDRAW_FILLED = 0,    /* Columns from value down to the bottom */
+    SPECDRAW_LINE           /* 1 px polyline, used for main and hold traces */
+} specdraw_mode_t;
+
+typedef struct {
+    uint32_t    *buf;       /* Pixel at buf_x, buf_y */
+    int32_t     stride;     /* Pixels per buffer row */
+    int16_t     buf_x;
+    int16_t     buf_y;
+
+    int16_t     clip_x1;    /* Inclusive, should be inside the buffer */
+    int16_t     clip_y1;
+    int16_t     clip_x2;
+    int16_t     clip_y2;
+} specdraw_canvas_t;
+
+typedef struct {
+    int16_t     x;          /* n values are spread over w columns */
+    int16_t     y;          /* max is drawn at y, min at y + h */
+    int16_t     w;
+    int16_t     h;
+    float       min;
+    float       max;
+} specdraw_area_t;
+
+/**
+ * Draw n values with color (0xAARRGGBB) and opacity 0..255
+ */
+void specdraw_trace(const specdraw_canvas_t *c, const specdraw_area_t *a, const float *v, uint16_t n,
+                    specdraw_mode_t mode, uint32_t color, uint8_t opa);
@@ -0,0 +1,200 @@
+/*
+ *  SPDX-License-Identifier: LGPL-2.1-or-later
+ *
+ *  Xiegu X6100 LVGL GUI
+ *
+ *  Copyright (c) 2024 Georgy Dyuldin aka R2RFE
+ */
+
+#include "trace.h"
+
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+struct trace_s {
+    uint16_t    size;
+    trace_avg_t mode;
+    float       tau_ms;
+    float       hold_ms;
+    float       release;    /* dB per ms */
+    bool        empty;
+
+    float       *avg;
+    float       *power;     /* Linear power of avg, TRACE_AVG_POWER only */
+    float       *max;
+    float       *min;
+    float       *max_time;  /* Remaining hold time */
+    float       *min_time;
+};
+
+trace_t trace_create(uint16_t size) {
+    trace_t t = (trace_t) malloc(sizeof(struct trace_s));
+
+    t->size = size;
+    t->mode = TRACE_AVG_DB;
+    t->tau_ms = 0.0f;
+    t->hold_ms = 0.0f;
+    t->release = 0.0f;
+
+    t->avg = malloc(size * sizeof(float));
+    t->power = malloc(size * sizeof(float));
+    t->max = malloc(size * sizeof(float));
+    t->min = malloc(size * sizeof(float));
+    t->max_time = malloc(size * sizeof(float));
+    t->min_time = malloc(size * sizeof(float));
+
+    trace_reset(t);
+
+    return t;
+}
+
+void trace_destroy(trace_t t) {
+    free(t->avg);
+    free(t->power);
+    free(t->max);
+    free(t->min);
+    free(t->max_time);
+    free(t->min_time);
+    free(t);
+}
+
+void trace_set_avg(trace_t t, trace_avg_t mode, float tau_ms) {
+    if (mode != t->mode && mode == TRACE_AVG_POWER && !t->empty) {
+        for (uint16_t i = 0; i < t->size; i++) {
+            t->power[i] = powf(10.0f, t->avg[i] * 0.1f);
+        }
+    }
+
+    t->mode = mode;
+    t->tau_ms = tau_ms;
+}
+
+void trace_set_hold(trace_t t, float hold_ms, float release_db_s) {
+    t->hold_ms = hold_ms;
+    t->release = release_db_s * 0.001f;
+}
+
+void trace_reset(trace_t t) {
+    t->empty = true;
+}
+
+static void init(trace_t t, const float *psd) {
+    memcpy(t->avg, psd, t->size * sizeof(float));
+    memcpy(t->max, psd, t->size * sizeof(float));
+    memcpy(t->min, psd, t->size * sizeof(float));
+
+    for (uint16_t i = 0; i < t->size; i++) {
+        t->power[i] = powf(10.0f, psd[i] * 0.1f);
+        t->max_time[i] = t->hold_ms;
+        t->min_time[i] = t->hold_ms;
+    }
+
+    t->empty = false;
+}
+
+static void update_avg(trace_t t, const float *psd, float dt_ms) {
+    float alpha = (t->tau_ms > 0.0f) ? 1.0f - expf(-dt_ms / t->tau_ms) : 1.0f;
+
+    if (t->mode == TRACE_AVG_POWER) {
+        for (uint16_t i = 0; i < t->size; i++) {
+            t->power[i] += alpha * (powf(10.0f, psd[i] * 0.1f) - t->power[i]);
+            t->avg[i] = 10.0f * log10f(t->power[i]);
+        }
+    } else {
+        for (uint16_t i = 0; i < t->size; i++) {
+            t->avg[i] += alpha * (psd[i] - t->avg[i]);
+        }
+    }
+}
+
+static void update_hold(trace_t t, float dt_ms) {
+    float release = t->release * dt_ms;
+
+    for (uint16_t i = 0; i < t->size; i++) {
+        float v = t->avg[i];
+
+        if (v >= t->max[i]) {
+            t->max[i] = v;
+            t->max_time[i] = t->hold_ms;
+        } else if (t->max_time[i] > 0.0f) {
+            t->max_time[i] -= dt_ms;
+        } else {
+            t->max[i] = fmaxf(t->max[i] - release, v);
+        }
+
+        if (v <= t->min[i]) {
+            t->min[i] = v;
+            t->min_time[i] = t->hold_ms;
+        } else if (t->min_time[i] > 0.0f) {
+            t->min_time[i] -= dt_ms;
+        } else {
+            t->min[i] = fminf(t->min[i] + release, v);
+        }
+    }
+}
+
+void trace_put(trace_t t, const float *psd, float dt_ms, bool hold) {
+    if (t->empty) {
+        init(t, psd);
+        return;
+    }
+
+    update_avg(t, psd, dt_ms);
+
+    if (hold) {
+        update_hold(t, dt_ms);
+    }
+}
+
+/**
+ * Vacated bins are taken from fill or set to zero without it
+ */
+static void shift(float *x, const float *fill, int16_t bins, uint16_t size) {
+    uint16_t from = 0;
+    uint16_t n = abs(bins);
+
+    if (bins > 0) {
+        memmove(&x[n], x, (size - n) * sizeof(float));
+    } else {
+        memmove(x, &x[n], (size - n) * sizeof(float));
+        from = size - n;
+    }
+
+    if (fill) {
+        memcpy(&x[from], &fill[from], n * sizeof(float));
+    } else {
+        memset(&x[from], 0, n * sizeof(float));
+    }
+}
+
+void trace_shift(trace_t t, int16_t bins) {
+    if (bins == 0 || t->empty) {
+        return;
+    }
+
+    if (abs(bins) >= t->size) {
+        memcpy(t->max, t->avg, t->size * sizeof(float));
+        memcpy(t->min, t->avg, t->size * sizeof(float));
+        memset(t->max_time, 0, t->size * sizeof(float));
+        memset(t->min_time, 0, t->size * sizeof(float));
+        return;
+    }
+
+    shift(t->max, t->avg, bins, t->size);
+    shift(t->min, t->avg, bins, t->size);
+    shift(t->max_time, NULL, bins, t->size);
+    shift(t->min_time, NULL, bins, t->size);
+}
+
+const float * trace_avg(trace_t t) {
+    return t->avg;
+}
+
+const float * trace_max(trace_t t) {
+    return t->max;
+}
+
+const float * trace_min(trace_t t) {
+    return t->min;
+}
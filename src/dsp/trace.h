@@ -0,0 +1,55 @@
+/*
+ *  SPDX-License-Identifier: LGPL-2.1-or-later
+ *
+ *  Xiegu X6100 LVGL GUI
+ *
+ *  Copyright (c) 2024 Georgy Dyuldin aka R2RFE
+ */
+
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/**
+ * Spectrum traces: average, max-hold and min-hold of PSD frames in dB.
+ *
+ * All dynamics are set in milliseconds and each frame is put with time
+ * passed since the previous one, so traces look the same at any frame
+ * rate. Average is exponential, in dB or in linear power domain. Max/min
+ * traces hold an extremum, then release towards the signal with fixed
+ * dB/s speed.
+ */
+typedef struct trace_s * trace_t;
+
+typedef enum {
+    TRACE_AVG_DB = 0,
+    TRACE_AVG_POWER
+} trace_avg_t;
+
+trace_t trace_create(uint16_t size);
+void trace_destroy(trace_t t);
+
+void trace_set_avg(trace_t t, trace_avg_t mode, float tau_ms);
+void trace_set_hold(trace_t t, float hold_ms, float release_db_s);
+
+/**
+ * Next frame initializes all traces
+ */
+void trace_reset(trace_t t);
+
+/**
+ * Put frame, dt_ms - time since previous frame. With hold off max/min
+ * traces are not updated
+ */
+void trace_put(trace_t t, const float *psd, float dt_ms, bool hold);
+
+/**
+ * Move hold traces by bins (out[i] = in[i - bins]), vacated bins take
+ * average value
+ */
+void trace_shift(trace_t t, int16_t bins);
+
+const float * trace_avg(trace_t t);
+const float * trace_max(trace_t t);
+const float * trace_min(trace_t t);
@@ -0,0 +1,236 @@
+/*
+ *  SPDX-License-Identifier: LGPL-2.1-or-later
+ *
+ *  Xiegu X6100 LVGL GUI
+ *
+ *  Copyright (c) 2024 Georgy Dyuldin aka R2RFE
+ */
+
+#include "wfhist.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+typedef struct {
+    int64_t     freq;
+    uint64_t    time;
+    int32_t     span;
+    uint32_t    offset;     /* In arena */
+    uint32_t    size;       /* Compressed */
+} entry_t;
+
+struct wfhist_s {
+    uint8_t     *arena;
+    size_t      arena_size;
+    size_t      head;       /* Next write position */
+    size_t      used;
+
+    entry_t     *entries;   /* By seq % max_rows */
+    uint32_t    max_rows;
+    uint32_t    first;
+    uint32_t    next;
+
+    uint16_t    width;
+    uint8_t     *packed;    /* Worst case of one row */
+};
+
+/**
+ * PackBits: header 0..127 - n + 1 literal bytes, 129..255 - next byte
+ * repeated 257 - n times
+ */
+static size_t pack(const uint8_t *x, size_t n, uint8_t *y) {
+    size_t  i = 0;
+    size_t  out = 0;
+
+    while (i < n) {
+        size_t run = 1;
+
+        while (i + run < n && run < 128 && x[i + run] == x[i]) {
+            run++;
+        }
+
+        if (run > 2) {
+            y[out++] = (uint8_t) (257 - run);
+            y[out++] = x[i];
+            i += run;
+            continue;
+        }
+
+        /* Literal until the next run of 3 or more, so it never grows more than 1/128 */
+        size_t lit = 1;
+
+        while (i + lit < n && lit < 128) {
+            if (i + lit + 2 < n && x[i + lit] == x[i + lit + 1] && x[i + lit] == x[i + lit + 2]) {
+                break;
+            }
+            lit++;
+        }
+
+        y[out++] = (uint8_t) (lit - 1);
+        memcpy(&y[out], &x[i], lit);
+        out += lit;
+        i += lit;
+    }
+
+    return out;
+}
+
+static void unpack(const uint8_t *x, size_t size, uint8_t *y, size_t n) {
+    size_t  i = 0;
+    size_t  out = 0;
+
+    while (i < size && out < n) {
+        uint8_t h = x[i++];
+
+        if (h < 128) {
+            size_t lit = h + 1;
+
+            if (lit > n - out) {
+                lit = n - out;
+            }
+            memcpy(&y[out], &x[i], lit);
+            out += lit;
+            i += h + 1;
+        } else if (h > 128) {
+            size_t run = 257 - h;
+
+            if (run > n - out) {
+                run = n - out;
+            }
+            memset(&y[out], x[i++], run);
+            out += run;
+        }
+    }
+
+    memset(&y[out], 0, n - out);
+}
+
+wfhist_t wfhist_create(size_t arena_size, uint32_t max_rows, uint16_t width) {
+    wfhist_t h = (wfhist_t) malloc(sizeof(struct wfhist_s));
+
+    h->arena = malloc(arena_size);
+    h->arena_size = arena_size;
+    h->entries = malloc(max_rows * sizeof(entry_t));
+    h->max_rows = max_rows;
+    h->width = width;
+    h->packed = malloc(width + width / 128 + 1);
+
+    wfhist_clear(h);
+
+    return h;
+}
+
+void wfhist_destroy(wfhist_t h) {
+    free(h->arena);
+    free(h->entries);
+    free(h->packed);
+    free(h);
+}
+
+void wfhist_clear(wfhist_t h) {
+    h->head = 0;
+    h->used = 0;
+    h->first = 0;
+    h->next = 0;
+}
+
+static entry_t * entry(wfhist_t h, uint32_t seq) {
+    return &h->entries[seq % h->max_rows];
+}
+
+static void drop_first(wfhist_t h) {
+    h->used -= entry(h, h->first)->size;
+    h->first++;
+}
+
+uint32_t wfhist_put(wfhist_t h, const uint8_t *row, int64_t freq, int32_t span, uint64_t time) {
+    size_t size = pack(row, h->width, h->packed);
+
+    if (h->next - h->first == h->max_rows) {
+        drop_first(h);
+    }
+
+    /* Record is contiguous. Tail of arena after wrap holds the oldest rows */
+    if (h->head + size > h->arena_size) {
+        while (h->first != h->next && entry(h, h->first)->offset >= h->head) {
+            drop_first(h);
+        }
+        h->head = 0;
+    }
+
+    while (h->first != h->next) {
+        entry_t *e = entry(h, h->first);
+
+        if (e->offset >= h->head + size || e->offset + e->size <= h->head) {
+            break;
+        }
+        drop_first(h);
+    }
+
+    entry_t *e = entry(h, h->next);
+
+    e->freq = freq;
+    e->time = time;
+    e->span = span;
+    e->offset = h->head;
+    e->size = size;
+
+    memcpy(&h->arena[h->head], h->packed, size);
+    h->head += size;
+    h->used += size;
+
+    return h->next++;
+}
+
+uint32_t wfhist_first(wfhist_t h) {
+    return h->first;
+}
+
+uint32_t wfhist_next(wfhist_t h) {
+    return h->next;
+}
+
+uint32_t wfhist_find(wfhist_t h, uint64_t time) {
+    uint32_t lo = h->first;
+    uint32_t hi = h->next;
+
+    /* First row later than time */
+    while (lo < hi) {
+        uint32_t mid = lo + (hi - lo) / 2;
+
+        if (entry(h, mid)->time <= time) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+
+    return lo > h->first ? lo - 1 : h->first;
+}
+
+bool wfhist_get(wfhist_t h, uint32_t seq, uint8_t *row, int64_t *freq, int32_t *span, uint64_t *time) {
+    if (seq - h->first >= h->next - h->first) {
+        return false;
+    }
+
+    entry_t *e = entry(h, seq);
+
+    if (row) {
+        unpack(&h->arena[e->offset], e->size, row, h->width);
+    }
+
+    if (freq) {
+        *freq = e->freq;
+    }
+    if (span) {
+        *span = e->span;
+    }
+    if (time) {
+        *time = e->time;
+    }
+    return true;
+}
+
+size_t wfhist_used(wfhist_t h) {
+    return h->used;
+}
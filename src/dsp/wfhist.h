@@ -0,0 +1,53 @@
+/*
+ *  SPDX-License-Identifier: LGPL-2.1-or-later
+ *
+ *  Xiegu X6100 LVGL GUI
+ *
+ *  Copyright (c) 2024 Georgy Dyuldin aka R2RFE
+ */
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+/**
+ * Waterfall history: quantized rows with their center frequency, span
+ * and time, PackBits compressed into fixed size arena. The oldest rows
+ * are dropped to free space.
+ *
+ * Rows are addressed by sequence number, it keeps pointing to the same
+ * row while new ones are put.
+ */
+typedef struct wfhist_s * wfhist_t;
+
+wfhist_t wfhist_create(size_t arena_size, uint32_t max_rows, uint16_t width);
+void wfhist_destroy(wfhist_t h);
+void wfhist_clear(wfhist_t h);
+
+/**
+ * Return sequence number of the row. Time should not decrease
+ */
+uint32_t wfhist_put(wfhist_t h, const uint8_t *row, int64_t freq, int32_t span, uint64_t time);
+
+/**
+ * Stored rows are first .. next - 1
+ */
+uint32_t wfhist_first(wfhist_t h);
+uint32_t wfhist_next(wfhist_t h);
+
+/**
+ * Newest row not later than time, or first one
+ */
+uint32_t wfhist_find(wfhist_t h, uint64_t time);
+
+/**
+ * Any of outputs may be NULL
+ */
+bool wfhist_get(wfhist_t h, uint32_t seq, uint8_t *row, int64_t *freq, int32_t *span, uint64_t *time);
+
+/**
+ * Compressed bytes in arena
+ */
+size_t wfhist_used(wfhist_t h);
@@ -9,6 +9,7 @@
 #include "worker.h"
 
 #include "../util.h"
+#include "../simd/simd.h"
 #include "gfsk.h"
 
 #include "lvgl/lvgl.h"
@@ -204,23 +205,11 @@ void ftx_worker_put_rx_samples(float complex *samples, uint32_t n_samples) {
 
         fft_execute(fft);
 
-        for (int freq_sub = 0; freq_sub < wf.freq_osr; freq_sub++)
-            for (int bin = 0; bin < wf.num_bins; bin++) {
-                int           src_bin = (bin * wf.freq_osr) + freq_sub;
-                complex float freq = freq_buf[src_bin];
-                float         mag2 = crealf(freq * conjf(freq));
-                float         db = 10.0f * log10f(mag2);
-                int           scaled = (int16_t)(db * 2.0f + 240.0f);
-
-                if (scaled < 0) {
-                    scaled = 0;
-                } else if (scaled > 255) {
-                    scaled = 255;
-                }
-
-                wf.mag[offset] = scaled;
-                offset++;
-            }
+        for (int freq_sub = 0; freq_sub < wf.freq_osr; freq_sub++) {
+            /* Every freq_osr bin starting from freq_sub, quantized to 0.5 dB */
+            simd_power_db_u8((const float *) &freq_buf[freq_sub], wf.num_bins, wf.freq_osr, 2.0f, 240.0f, &wf.mag[offset]);
+            offset += wf.num_bins;
+        }
     }
     wf.num_blocks++;
 }
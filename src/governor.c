@@ -0,0 +1,244 @@
+/*
+ *  SPDX-License-Identifier: LGPL-2.1-or-later
+ *
+ *  Xiegu X6100 LVGL GUI
+ *
+ *  Copyright (c) 2024 Georgy Dyuldin aka R2RFE
+ */
+
+#include "governor.h"
+
+#include "assets.h"
+#include "dsp.h"
+#include "dialog_ft8.h"
+#include "backlight.h"
+#include "static_layer.h"
+#include "styles.h"
+#include "params/params.h"
+
+#include <stdatomic.h>
+#include <stdio.h>
+#include <time.h>
+#include <unistd.h>
+
+#define PERIOD_MS       1000
+#define SCALE_DOWN      0.15f       /* Per period over budget */
+#define SCALE_UP        0.05f       /* Per period under budget * HEADROOM */
+#define HEADROOM        0.8f
+
+typedef struct {
+    float   budget;                 /* Part of all cores */
+    uint8_t spectrum_fps[2];        /* Min, max */
+    uint8_t waterfall_fps[2];
+    uint8_t ft8_fps[2];
+    uint8_t refr_fps[2];
+} policy_t;
+
+static const policy_t policies[] = {
+    [GOVERNOR_PERFORMANCE]  = { .budget = 0.90f, .spectrum_fps = { 10, 25 }, .waterfall_fps = { 15, 30 }, .ft8_fps = { 2, 5 }, .refr_fps = { 20, 50 } },
+    [GOVERNOR_BALANCED]     = { .budget = 0.60f, .spectrum_fps = { 5, 15 },  .waterfall_fps = { 10, 25 }, .ft8_fps = { 2, 5 }, .refr_fps = { 15, 33 } },
+    [GOVERNOR_BATTERY]      = { .budget = 0.35f, .spectrum_fps = { 5, 10 },  .waterfall_fps = { 8, 15 },  .ft8_fps = { 1, 3 }, .refr_fps = { 10, 20 } },
+};
+
+static const policy_t   *policy = &policies[GOVERNOR_BALANCED];
+static float            scale = 1.0f;
+static float            scale_saved;        /* Before backlight off, restored on wake */
+static bool             dimmed = false;
+static uint8_t          cores = 1;
+
+static atomic_ullong    stage_us[GOVERNOR_STAGES];
+static atomic_uint      frames;
+
+static lv_timer_t       *refr_timer;
+static lv_timer_cb_t    refr_cb;
+static void             (*flush_cb)(struct _lv_disp_drv_t *, const lv_area_t *, lv_color_t *);
+
+static uint64_t         last_us;
+static uint64_t         last_cpu_us;
+
+static lv_obj_t         *readout = NULL;
+static static_layer_stats_t layers_last;
+static assets_stats_t   assets_last;
+
+static uint64_t cpu_time_us() {
+    struct timespec now;
+
+    clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &now);
+
+    return (uint64_t) now.tv_sec * 1000000L + now.tv_nsec / 1000L;
+}
+
+uint64_t governor_time_us() {
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+
+    return (uint64_t) now.tv_sec * 1000000L + now.tv_nsec / 1000L;
+}
+
+void governor_add(governor_stage_t stage, uint64_t begin_us) {
+    atomic_fetch_add(&stage_us[stage], governor_time_us() - begin_us);
+}
+
+/**
+ * Refresh timer of display, render and flush together
+ */
+static void refr_timer_cb(lv_timer_t *t) {
+    uint64_t    begin = governor_time_us();
+    uint64_t    flush = atomic_load(&stage_us[GOVERNOR_FLUSH]);
+
+    refr_cb(t);
+
+    uint64_t    total = governor_time_us() - begin;
+
+    flush = atomic_load(&stage_us[GOVERNOR_FLUSH]) - flush;
+
+    if (flush) {
+        atomic_fetch_add(&stage_us[GOVERNOR_RENDER], total - flush);
+        atomic_fetch_add(&frames, 1);
+    }
+}
+
+static void flush_wrap_cb(lv_disp_drv_t *drv, const lv_area_t *area, lv_color_t *color_p) {
+    uint64_t begin = governor_time_us();
+
+    flush_cb(drv, area, color_p);
+    governor_add(GOVERNOR_FLUSH, begin);
+}
+
+static uint8_t rate(const uint8_t *limits) {
+    return limits[0] + (limits[1] - limits[0]) * scale + 0.5f;
+}
+
+static void apply() {
+    uint8_t refr = rate(policy->refr_fps);
+
+    dsp_set_fps(rate(policy->spectrum_fps), rate(policy->waterfall_fps));
+    dialog_ft8_set_fps(rate(policy->ft8_fps));
+
+    if (refr_timer) {
+        lv_timer_set_period(refr_timer, 1000 / refr);
+    }
+}
+
+static void governor_timer(lv_timer_t *t) {
+    uint64_t    now = governor_time_us();
+    uint64_t    cpu = cpu_time_us();
+    float       wall = now - last_us;
+    float       load = (cpu - last_cpu_us) / wall / cores;
+    uint64_t    us[GOVERNOR_STAGES];
+
+    for (uint8_t i = 0; i < GOVERNOR_STAGES; i++) {
+        us[i] = atomic_exchange(&stage_us[i], 0);
+    }
+
+    uint32_t    n = atomic_exchange(&frames, 0);
+
+    last_us = now;
+    last_cpu_us = cpu;
+
+    if (!backlight_is_on()) {
+        if (!dimmed) {
+            scale_saved = scale;
+            dimmed = true;
+        }
+        scale = 0.0f;
+    } else if (dimmed) {
+        scale = scale_saved;
+        dimmed = false;
+    } else if (load > policy->budget) {
+        scale -= SCALE_DOWN * load / policy->budget;
+    } else if (load < policy->budget * HEADROOM) {
+        scale += SCALE_UP;
+    }
+
+    scale = LV_CLAMP(0.0f, scale, 1.0f);
+    apply();
+
+    static_layer_stats_t layers;
+
+    static_layer_get_stats(NULL, &layers);
+
+    uint32_t    renders = layers.renders - layers_last.renders;
+    uint32_t    draws = layers.draws - layers_last.draws;
+    uint64_t    render_us = layers.render_us - layers_last.render_us;
+    uint64_t    draw_us = layers.draw_us - layers_last.draw_us;
+
+    layers_last = layers;
+
+    assets_stats_t assets;
+
+    assets_get_stats(&assets);
+
+    uint32_t    hits = assets.hits - assets_last.hits;
+    uint32_t    misses = assets.misses - assets_last.misses;
+
+    assets_last = assets;
+
+    if (readout) {
+        lv_label_set_text_fmt(readout,
+            "CPU %2i%% DSP %2i%% Render %.1f Flush %.1f ms\n"
+            "Spectrum %i Waterfall %i FT8 %i Display %i/%i fps\n"
+            "Static layers %u renders %.1f ms, %u blits %.2f ms\n"
+            "Images %u (%u KB mapped, %u KB heap) %u hits %u misses %u failed",
+            (int) (load * 100.0f), (int) (us[GOVERNOR_DSP] * 100 / wall),
+            n ? us[GOVERNOR_RENDER] / 1000.0f / n : 0.0f,
+            n ? us[GOVERNOR_FLUSH] / 1000.0f / n : 0.0f,
+            rate(policy->spectrum_fps), rate(policy->waterfall_fps), rate(policy->ft8_fps),
+            (int) (n * 1000000.0f / wall + 0.5f), rate(policy->refr_fps),
+            renders, renders ? render_us / 1000.0f / renders : 0.0f,
+            draws, draws ? draw_us / 1000.0f / draws : 0.0f,
+            assets.images, (uint32_t) (assets.mapped_bytes / 1024), (uint32_t) (assets.heap_bytes / 1024), hits, misses, assets.failed
+        );
+    }
+}
+
+void governor_init(lv_disp_drv_t *drv) {
+    long n = sysconf(_SC_NPROCESSORS_ONLN);
+
+    cores = n > 0 ? n : 1;
+
+    refr_timer = _lv_disp_get_refr_timer(drv->disp);
+
+    if (refr_timer) {
+        refr_cb = refr_timer->timer_cb;
+        refr_timer->timer_cb = refr_timer_cb;
+    }
+
+    flush_cb = drv->flush_cb;
+    drv->flush_cb = flush_wrap_cb;
+
+    last_us = governor_time_us();
+    last_cpu_us = cpu_time_us();
+
+    governor_set_policy(params.governor_policy.x);
+    governor_set_readout(params.governor_readout.x);
+
+    lv_timer_create(governor_timer, PERIOD_MS, NULL);
+}
+
+void governor_set_policy(governor_policy_t x) {
+    if (x > GOVERNOR_BATTERY) {
+        x = GOVERNOR_BALANCED;
+    }
+
+    policy = &policies[x];
+    apply();
+}
+
+void governor_set_readout(bool on) {
+    if (on && !readout) {
+        readout = lv_label_create(lv_layer_top());
+
+        lv_obj_set_style_text_font(readout, &sony_14, 0);
+        lv_obj_set_style_text_color(readout, lv_color_white(), 0);
+        lv_obj_set_style_bg_color(readout, lv_color_black(), 0);
+        lv_obj_set_style_bg_opa(readout, LV_OPA_60, 0);
+        lv_obj_set_style_pad_all(readout, 2, 0);
+        lv_obj_align(readout, LV_ALIGN_BOTTOM_LEFT, 0, 0);
+        lv_label_set_text(readout, "");
+    } else if (!on && readout) {
+        lv_obj_del(readout);
+        readout = NULL;
+    }
+}
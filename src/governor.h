@@ -0,0 +1,54 @@
+/*
+ *  SPDX-License-Identifier: LGPL-2.1-or-later
+ *
+ *  Xiegu X6100 LVGL GUI
+ *
+ *  Copyright (c) 2024 Georgy Dyuldin aka R2RFE
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "lvgl/lvgl.h"
+
+/**
+ * Render-rate governor. Measures DSP, render and flush time and process
+ * CPU load, and scales spectrum, waterfall, FT8 waterfall and display
+ * refresh rates between the limits of the policy to hold its CPU budget.
+ */
+
+#define GOVERNOR_POLICY_OPTIONS " Performance \n Balanced \n Battery "
+
+typedef enum {
+    GOVERNOR_PERFORMANCE = 0,
+    GOVERNOR_BALANCED,
+    GOVERNOR_BATTERY
+} governor_policy_t;
+
+typedef enum {
+    GOVERNOR_DSP = 0,
+    GOVERNOR_RENDER,
+    GOVERNOR_FLUSH,
+
+    GOVERNOR_STAGES
+} governor_stage_t;
+
+/**
+ * Hooks display refresh and flush of drv, starts control timer
+ */
+void governor_init(lv_disp_drv_t *drv);
+
+void governor_set_policy(governor_policy_t policy);
+
+/**
+ * On-screen readout of load and rates
+ */
+void governor_set_readout(bool on);
+
+/**
+ * Stage timing, thread safe. Time in microseconds
+ */
+uint64_t governor_time_us();
+void governor_add(governor_stage_t stage, uint64_t begin_us);
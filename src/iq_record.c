@@ -0,0 +1,397 @@
+/*
+ *  SPDX-License-Identifier: LGPL-2.1-or-later
+ *
+ *  Xiegu X6100 LVGL GUI
+ *
+ *  Copyright (c) 2024 Georgy Dyuldin aka R2RFE
+ */
+
+#include "iq_record.h"
+
+#include "lvgl/lvgl.h"
+#include "dsp.h"
+#include "radio.h"
+#include "recorder.h"
+#include "msg.h"
+#include "spsc_ring.h"
+#include "params/params.h"
+#include "dsp/iqfile.h"
+
+#include <pthread.h>
+#include <semaphore.h>
+#include <stdatomic.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#define SAMPLE_RATE     100000
+#define LIVE_BLOCKS     256         /* ~1.3 s of flow */
+#define REPLAY_QUEUE    8           /* Max DSP queue in fast replay */
+#define PRE_CHUNK       32          /* Pre-trigger packets written between live ring drains */
+
+typedef struct {
+    iqfile_packet_t packet;
+    float complex   samples[RADIO_SAMPLES];
+} iq_packet_t;
+
+/* Owner of DSP input, it has one producer only */
+typedef enum {
+    DSP_RADIO = 0,
+    DSP_REQUEST,    /* Replay waits for radio thread to hand over */
+    DSP_REPLAY
+} dsp_owner_t;
+
+static spsc_ring_t      live_ring;
+static sem_t            writer_sem;
+static iqfile_t         file = NULL;
+static atomic_bool      recording = false;
+static atomic_bool      busy = false;
+static atomic_bool      pretrigger_pending = false;
+static atomic_bool      stop_request = false;
+static bool             write_error = false;    /* Writer thread only */
+
+static pthread_mutex_t  pre_mux = PTHREAD_MUTEX_INITIALIZER;
+static iq_packet_t      *pre_buf = NULL;
+static size_t           pre_size = 0;
+static size_t           pre_head = 0;
+static size_t           pre_count = 0;
+
+static atomic_bool      replay_on = false;     /* Replay thread is running */
+static atomic_bool      replay_run = false;    /* Cleared by stop */
+static atomic_int       dsp_owner = DSP_RADIO;
+static char             replay_path[128];
+static bool             replay_realtime;
+
+static uint64_t get_time_us() {
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+
+    return (uint64_t) now.tv_sec * 1000000L + now.tv_nsec / 1000L;
+}
+
+static void fill_packet(iq_packet_t *p, float complex *samples, uint16_t size, bool tx) {
+    p->packet.time_us = get_time_us();
+    p->packet.flags = tx ? IQFILE_FLAG_TX : 0;
+    p->packet.count = size;
+    memcpy(p->samples, samples, size * sizeof(float complex));
+}
+
+/**
+ * On error recording is stopped as by user, rest of packets is dropped
+ */
+static bool write_packet(const iq_packet_t *p) {
+    if (write_error) {
+        return false;
+    }
+
+    if (iqfile_write(file, &p->packet, p->samples)) {
+        return true;
+    }
+
+    write_error = true;
+
+    if (atomic_exchange(&recording, false)) {
+        LV_LOG_ERROR("IQ recorder write error");
+        msg_update_text_fmt("IQ recording stopped, write error");
+        atomic_store(&stop_request, true);
+    }
+
+    return false;
+}
+
+/**
+ * Pre-trigger goes first. Live packets keep coming meanwhile, they are
+ * moved to freed slots of the pre-trigger buffer, so the order is kept and
+ * the live ring does not overrun during long flush
+ */
+static void write_pretrigger() {
+    pthread_mutex_lock(&pre_mux);
+
+    while (pre_count) {
+        size_t i = (pre_head + pre_size - pre_count) % pre_size;
+
+        for (uint8_t n = 0; n < PRE_CHUNK && pre_count; n++, pre_count--) {
+            write_packet(&pre_buf[i]);
+            i = (i + 1) % pre_size;
+        }
+
+        if (write_error) {
+            pre_count = 0;
+            break;
+        }
+
+        iq_packet_t *p;
+
+        while (pre_count < pre_size && (p = spsc_ring_read_begin(live_ring))) {
+            iq_packet_t *to = &pre_buf[pre_head];
+
+            to->packet = p->packet;
+            memcpy(to->samples, p->samples, p->packet.count * sizeof(float complex));
+            spsc_ring_read_commit(live_ring);
+
+            pre_head = (pre_head + 1) % pre_size;
+            pre_count++;
+        }
+    }
+
+    pthread_mutex_unlock(&pre_mux);
+}
+
+static void * writer_thread(void *arg) {
+    while (true) {
+        sem_wait(&writer_sem);
+
+        if (atomic_exchange(&pretrigger_pending, false) && pre_size) {
+            write_pretrigger();
+        }
+
+        iq_packet_t *p;
+
+        while ((p = spsc_ring_read_begin(live_ring))) {
+            if (file) {
+                write_packet(p);
+            }
+            spsc_ring_read_commit(live_ring);
+        }
+
+        if (atomic_exchange(&stop_request, false)) {
+            iqfile_close(file);
+            file = NULL;
+            write_error = false;
+
+            uint32_t overruns = spsc_ring_overruns(live_ring);
+
+            if (overruns) {
+                LV_LOG_WARN("IQ recorder dropped %u packets", overruns);
+            }
+            atomic_store(&busy, false);
+        }
+    }
+
+    return NULL;
+}
+
+void iq_record_init() {
+    live_ring = spsc_ring_create(sizeof(iq_packet_t), LIVE_BLOCKS);
+    sem_init(&writer_sem, 0, 0);
+
+    iq_record_set_pretrigger(iq_record_pretrigger_seconds(params.iq_pretrigger.x));
+
+    pthread_t thread;
+
+    pthread_create(&thread, NULL, writer_thread, NULL);
+    pthread_detach(thread);
+}
+
+void iq_record_put(float complex *samples, uint16_t size, bool tx) {
+    if (size > RADIO_SAMPLES) {
+        size = RADIO_SAMPLES;
+    }
+
+    if (atomic_load(&recording)) {
+        iq_packet_t *p = spsc_ring_write_begin(live_ring);
+
+        if (p) {
+            fill_packet(p, samples, size, tx);
+            spsc_ring_write_commit(live_ring);
+            sem_post(&writer_sem);
+        }
+    } else if (pre_size && pthread_mutex_trylock(&pre_mux) == 0) {
+        /* Never wait, skip packet if buffer is busy */
+        if (pre_size) {
+            fill_packet(&pre_buf[pre_head], samples, size, tx);
+            pre_head = (pre_head + 1) % pre_size;
+
+            if (pre_count < pre_size) {
+                pre_count++;
+            }
+        }
+        pthread_mutex_unlock(&pre_mux);
+    }
+}
+
+bool iq_record_start() {
+    if (atomic_load(&busy)) {
+        return false;
+    }
+
+    char        filename[64];
+    time_t      now = time(NULL);
+    struct tm   *t = localtime(&now);
+
+    snprintf(filename, sizeof(filename),
+        "%s/IQ_%04i%02i%02i_%02i%02i%02i",
+        recorder_path, t->tm_year + 1900, t->tm_mon + 1, t->tm_mday, t->tm_hour, t->tm_min, t->tm_sec
+    );
+
+    iqfile_meta_t meta = {
+        .sample_rate = SAMPLE_RATE,
+        .frequency = params_band_cur_freq_get(),
+        .description = "X6100 baseband flow"
+    };
+
+    file = iqfile_create(filename, &meta);
+
+    if (!file) {
+        LV_LOG_ERROR("Problem with create file %s", filename);
+        return false;
+    }
+
+    atomic_store(&busy, true);
+    atomic_store(&pretrigger_pending, true);
+    atomic_store(&recording, true);
+    sem_post(&writer_sem);
+
+    return true;
+}
+
+void iq_record_stop() {
+    if (!atomic_exchange(&recording, false)) {
+        return;
+    }
+
+    atomic_store(&stop_request, true);
+    sem_post(&writer_sem);
+}
+
+bool iq_record_is_on() {
+    return atomic_load(&recording);
+}
+
+uint8_t iq_record_pretrigger_seconds(uint8_t id) {
+    static const uint8_t seconds[] = { 0, 5, 10, 30 };
+
+    return id < sizeof(seconds) ? seconds[id] : 0;
+}
+
+void iq_record_set_pretrigger(uint8_t seconds) {
+    size_t size = (size_t) seconds * SAMPLE_RATE / RADIO_SAMPLES;
+
+    pthread_mutex_lock(&pre_mux);
+
+    if (size != pre_size) {
+        free(pre_buf);
+        pre_buf = size ? malloc(size * sizeof(iq_packet_t)) : NULL;
+        pre_size = pre_buf ? size : 0;
+    }
+    pre_head = 0;
+    pre_count = 0;
+
+    pthread_mutex_unlock(&pre_mux);
+}
+
+/**
+ * Wait until radio thread stops feeding DSP. False if replay is stopped before
+ */
+static bool take_dsp() {
+    atomic_store(&dsp_owner, DSP_REQUEST);
+
+    while (atomic_load(&dsp_owner) != DSP_REPLAY) {
+        if (!atomic_load(&replay_run)) {
+            /* Nothing was fed yet, radio keeps or takes back DSP input */
+            atomic_store(&dsp_owner, DSP_RADIO);
+            return false;
+        }
+        usleep(1000);
+    }
+
+    return true;
+}
+
+static void * replay_thread(void *arg) {
+    iqfile_t f = iqfile_open(replay_path);
+
+    if (!f) {
+        LV_LOG_ERROR("Problem with open file %s", replay_path);
+        atomic_store(&replay_on, false);
+        return NULL;
+    }
+
+    if (!take_dsp()) {
+        iqfile_close(f);
+        atomic_store(&replay_on, false);
+        return NULL;
+    }
+
+    iqfile_packet_t packet;
+    float complex   samples[RADIO_SAMPLES];
+    uint64_t        start_us = get_time_us();
+    uint64_t        first_us = 0;
+    bool            first = true;
+
+    dsp_reset();
+
+    while (atomic_load(&replay_run) && iqfile_read(f, &packet, samples, RADIO_SAMPLES)) {
+        if (first) {
+            first_us = packet.time_us;
+            first = false;
+        }
+
+        if (replay_realtime) {
+            uint64_t target = start_us + (packet.time_us - first_us);
+            uint64_t now = get_time_us();
+
+            if (target > now) {
+                usleep(target - now);
+            }
+        } else {
+            while (dsp_get_queued() > REPLAY_QUEUE && atomic_load(&replay_run)) {
+                usleep(500);
+            }
+        }
+
+        dsp_samples(samples, packet.count, packet.flags & IQFILE_FLAG_TX);
+    }
+
+    LV_LOG_USER("IQ replay: %zu packets in %llu ms", iqfile_packets(f),
+        (unsigned long long) (get_time_us() - start_us) / 1000);
+
+    iqfile_close(f);
+    dsp_reset();
+
+    /* No more dsp_samples() from this thread, radio may feed DSP again */
+    atomic_store(&dsp_owner, DSP_RADIO);
+    atomic_store(&replay_on, false);
+
+    return NULL;
+}
+
+bool iq_replay_start(const char *path, bool realtime) {
+    if (atomic_exchange(&replay_on, true)) {
+        return false;
+    }
+
+    strncpy(replay_path, path, sizeof(replay_path) - 1);
+    replay_realtime = realtime;
+    atomic_store(&replay_run, true);
+
+    pthread_t thread;
+
+    if (pthread_create(&thread, NULL, replay_thread, NULL) != 0) {
+        atomic_store(&replay_on, false);
+        return false;
+    }
+    pthread_detach(thread);
+
+    return true;
+}
+
+void iq_replay_stop() {
+    atomic_store(&replay_run, false);
+}
+
+bool iq_replay_is_on() {
+    return atomic_load(&replay_on);
+}
+
+bool iq_replay_owns_dsp() {
+    int expected = DSP_REQUEST;
+
+    /* Radio thread is not in dsp_samples() now, hand over */
+    atomic_compare_exchange_strong(&dsp_owner, &expected, DSP_REPLAY);
+
+    return atomic_load(&dsp_owner) != DSP_RADIO;
+}
@@ -0,0 +1,61 @@
+/*
+ *  SPDX-License-Identifier: LGPL-2.1-or-later
+ *
+ *  Xiegu X6100 LVGL GUI
+ *
+ *  Copyright (c) 2024 Georgy Dyuldin aka R2RFE
+ */
+
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <complex.h>
+
+/**
+ * Baseband IQ recorder and replay.
+ *
+ * Recording goes to recorder_path as SigMF .sigmf-data + .sigmf-meta pair
+ * with packet index next to them. Packets are passed to a writer thread,
+ * radio thread never blocks on file IO.
+ * Optional pre-trigger keeps the last seconds in RAM, they are written at
+ * the beginning of next recording.
+ */
+
+void iq_record_init();
+
+/**
+ * Called from radio thread for each flow packet
+ */
+void iq_record_put(float complex *samples, uint16_t size, bool tx);
+
+bool iq_record_start();
+void iq_record_stop();
+bool iq_record_is_on();
+
+#define IQ_PRETRIGGER_OPTIONS   " Off \n 5 s \n 10 s \n 30 s"
+
+/**
+ * Pre-trigger length, 0 - disabled
+ */
+void iq_record_set_pretrigger(uint8_t seconds);
+
+/**
+ * Seconds for IQ_PRETRIGGER_OPTIONS item
+ */
+uint8_t iq_record_pretrigger_seconds(uint8_t id);
+
+/**
+ * Feed recorded file to dsp_samples() instead of radio flow.
+ * With realtime off, file is played as fast as DSP thread can consume it
+ */
+bool iq_replay_start(const char *path, bool realtime);
+void iq_replay_stop();
+bool iq_replay_is_on();
+
+/**
+ * Called from radio thread before each dsp_samples(), DSP ring has one
+ * producer. Hands DSP input over to replay when it asks, returns true
+ * until replay thread is done with it
+ */
+bool iq_replay_owns_dsp();
@@ -7,8 +7,13 @@
  */
 
 #include "lvgl/lvgl.h"
+#ifdef SIMULATOR
+#include "sim/fb.h"
+#else
 #include "lv_drivers/display/fbdev.h"
+#endif
 #include <unistd.h>
+#include <stdlib.h>
 #include <pthread.h>
 #include <time.h>
 #include <sys/time.h>
@@ -38,15 +43,22 @@
 #include "qso_log.h"
 #include "scheduler.h"
 #include "wifi.h"
-
-#define DISP_BUF_SIZE (800 * 480 * 4)
+#include "iq_record.h"
+#include "governor.h"
+#include "recorder.h"
+#include "display.h"
+#include "assets.h"
 
 rotary_t                    *vol;
 encoder_t                   *mfk;
 
-static lv_color_t           buf[DISP_BUF_SIZE];
-static lv_disp_draw_buf_t   disp_buf;
-static lv_disp_drv_t        disp_drv;
+#ifdef SIMULATOR
+static const display_backend_t  backend = { .page = sim_fb_page, .flush = sim_fb_flush };
+#else
+static const display_backend_t  backend = {
+    .page = fbdev_get_page, .present = fbdev_present, .flush = fbdev_flush
+};
+#endif
 
 void * tick_thread (void *args);
 
@@ -54,21 +66,15 @@ int main(void) {
     lv_init();
     // lv_png_init();
 
+#ifdef SIMULATOR
+    sim_fb_init();
+#else
     fbdev_init();
+#endif
     audio_init();
     event_init();
 
-    lv_disp_draw_buf_init(&disp_buf, buf, NULL, DISP_BUF_SIZE);
-    lv_disp_drv_init(&disp_drv);
-
-    disp_drv.draw_buf   = &disp_buf;
-    disp_drv.flush_cb   = fbdev_flush;
-    disp_drv.hor_res    = 480;
-    disp_drv.ver_res    = 800;
-    disp_drv.sw_rotate  = 1;
-    disp_drv.rotated    = LV_DISP_ROT_90;
-
-    lv_disp_drv_register(&disp_drv);
+    lv_disp_drv_t *disp_drv = display_init(&backend);
 
     lv_disp_set_bg_color(lv_disp_get_default(), lv_color_black());
     lv_disp_set_bg_opa(lv_disp_get_default(), LV_OPA_COVER);
@@ -83,6 +89,12 @@ int main(void) {
     vol = rotary_init("/dev/input/event2");
     mfk = encoder_init("/dev/input/event3");
 
+#ifdef SIMULATOR
+    /* No radio input devices on host, keep objects for their mode state */
+    if (!vol) vol = calloc(1, sizeof(rotary_t));
+    if (!mfk) mfk = calloc(1, sizeof(encoder_t));
+#endif
+
     vol->left[VOL_EDIT] = KEY_VOL_LEFT_EDIT;
     vol->right[VOL_EDIT] = KEY_VOL_RIGHT_EDIT;
 
@@ -94,13 +106,16 @@ int main(void) {
     audio_set_rec_vol(params.rec_gain_db_f.x);
     mfk_change_mode(0);
     vol_change_mode(0);
+    assets_init(false);
     styles_init(params.theme.x);
 
     dsp_init(params_current_mode_spectrum_factor_get());
+    iq_record_init();
     lv_obj_t *main_obj = main_screen();
 
     cw_init();
     rtty_init();
+    recorder_init();
     radio_init(
         &main_screen_notify_tx,
         &main_screen_notify_rx,
@@ -108,6 +123,7 @@ int main(void) {
     );
     wifi_power_setup();
     backlight_init();
+    governor_init(disp_drv);
     cat_init();
     pannel_visible();
     gps_init();
@@ -116,6 +132,12 @@ int main(void) {
     }
     qso_log_import_adif("/mnt/incoming_log.adi");
 
+    const char *iq_replay = getenv("X6100_IQ_REPLAY");
+
+    if (iq_replay) {
+        iq_replay_start(iq_replay, true);
+    }
+
     pthread_t thread;
     pthread_create(&thread, NULL, tick_thread, NULL);
     pthread_detach(thread);
@@ -9,11 +9,11 @@
 #include "meter.h"
 #include "styles.h"
 #include "events.h"
-#include "params/params.h"
-#include "spectrum.h"
 #include "util.h"
+#include "static_layer.h"
 
 #define NUM_ITEMS   7
+#define SLICE_DB    3
 #define METER_PEAK_HOLD 1500
 #define METER_PEAK_SPEED 20
 
@@ -28,6 +28,7 @@ static int64_t          meter_peak_time;
 static int64_t          now;
 
 static lv_obj_t         *obj;
+static static_layer_t   scale;
 
 typedef struct {
     char    *label;
@@ -44,22 +45,59 @@ static s_item_t s_items[NUM_ITEMS] = {
     { .label = "+40",   .db = S9_40 }
 };
 
+static uint8_t slice_width(const lv_area_t *coords) {
+    lv_coord_t  w = lv_area_get_width(coords) - 80;
+    uint8_t     slices_total = (max_db - min_db) / SLICE_DB;
+
+    return w / slices_total;
+}
+
+/**
+ * Scale labels, drawn once into static layer
+ */
+static void scale_draw_cb(lv_draw_ctx_t *draw_ctx, const lv_area_t *coords) {
+    lv_draw_label_dsc_t label_dsc;
+    lv_area_t           area;
+
+    lv_coord_t x1 = coords->x1 + 7;
+    lv_coord_t y1 = coords->y1 + 17;
+
+    uint8_t     slice_w = slice_width(coords);
+
+    lv_draw_label_dsc_init(&label_dsc);
+
+    label_dsc.color = lv_color_white();
+    label_dsc.font = &sony_22;
+
+    area.y1 = y1 + 5;
+    area.y2 = area.y1 + 18;
+
+    lv_point_t label_size;
+
+    for (uint8_t i = 0; i < NUM_ITEMS; i++) {
+        char    *label = s_items[i].label;
+        int16_t db = s_items[i].db;
+
+        lv_txt_get_size(&label_size, label, label_dsc.font, 0, 0, LV_COORD_MAX, 0);
+
+        area.x1 = x1 + 30 + slice_w * ((db  - min_db) / SLICE_DB) - label_size.x / 2;
+        area.x2 = area.x1 + label_size.x;
+
+        lv_draw_label(draw_ctx, &label_dsc, &area, label, NULL);
+    }
+}
+
 static void meter_draw_cb(lv_event_t * e) {
     lv_obj_t            *obj = lv_event_get_target(e);
     lv_draw_ctx_t       *draw_ctx = lv_event_get_draw_ctx(e);
     lv_draw_rect_dsc_t  rect_dsc;
-    lv_draw_label_dsc_t label_dsc;
     lv_area_t           area;
 
     lv_coord_t x1 = obj->coords.x1 + 7;
     lv_coord_t y1 = obj->coords.y1 + 17;
 
-    lv_coord_t w = lv_obj_get_width(obj) - 80;
-    lv_coord_t h = lv_obj_get_height(obj) - 1;
-
-    uint8_t     slice_db = 3;
-    uint8_t     slices_total = (max_db - min_db) / slice_db;
-    uint8_t     slice_w = w / slices_total;
+    uint8_t     slices_total = (max_db - min_db) / SLICE_DB;
+    uint8_t     slice_w = slice_width(&obj->coords);
     uint8_t     slice_spacing = slice_w * 2 / 10;
 
     /* Rects */
@@ -68,7 +106,7 @@ static void meter_draw_cb(lv_event_t * e) {
 
     rect_dsc.bg_opa = LV_OPA_80;
 
-    uint32_t count = (meter_db - min_db + slice_db) / slice_db;
+    uint32_t count = (meter_db - min_db + SLICE_DB) / SLICE_DB;
     count = LV_MIN(count, slices_total);
 
     area.y1 = y1 - 5;
@@ -91,12 +129,12 @@ static void meter_draw_cb(lv_event_t * e) {
 
         lv_draw_rect(draw_ctx, &rect_dsc, &area);
 
-        db += slice_db;
+        db += SLICE_DB;
     }
 
     /* Peak */
     if (meter_peak > meter_db) {
-        area.x1 = x1 + 30  - slice_w / 2 + slice_w * ((meter_peak - min_db) / slice_db);
+        area.x1 = x1 + 30  - slice_w / 2 + slice_w * ((meter_peak - min_db) / SLICE_DB);
         area.x2 = area.x1 + slice_w - slice_spacing;
         rect_dsc.bg_opa = LV_OPA_50;
         rect_dsc.bg_color = lv_color_hex(0xAAAAAA);
@@ -105,29 +143,7 @@ static void meter_draw_cb(lv_event_t * e) {
 
     /* Labels */
 
-    lv_draw_label_dsc_init(&label_dsc);
-
-    label_dsc.color = lv_color_white();
-    label_dsc.font = &sony_22;
-
-    area.x1 = x1;
-    area.x2 = x1 + 20;
-    area.y1 = y1 + 5;
-    area.y2 = area.y1 + 18;
-
-    lv_point_t label_size;
-
-    for (uint8_t i = 0; i < NUM_ITEMS; i++) {
-        char    *label = s_items[i].label;
-        int16_t db = s_items[i].db;
-
-        lv_txt_get_size(&label_size, label, label_dsc.font, 0, 0, LV_COORD_MAX, 0);
-
-        area.x1 = x1 + 30 + slice_w * ((db  - min_db) / slice_db) - label_size.x / 2;
-        area.x2 = area.x1 + label_size.x;
-
-        lv_draw_label(draw_ctx, &label_dsc, &area, label, NULL);
-    }
+    static_layer_draw(scale, draw_ctx, &obj->coords);
 }
 
 static void tx_cb(lv_event_t * e) {
@@ -140,6 +156,7 @@ static void rx_cb(lv_event_t * e) {
 
 lv_obj_t * meter_init(lv_obj_t * parent) {
     obj = lv_obj_create(parent);
+    scale = static_layer_create("meter", scale_draw_cb);
 
     lv_obj_add_style(obj, &meter_style, 0);
 
@@ -150,16 +167,10 @@ lv_obj_t * meter_init(lv_obj_t * parent) {
     return obj;
 }
 
-void meter_update(int16_t db, float beta) {
-    noise_level = spectrum_get_min();
-    if (params_band_cur_att_get()) {
-        db += 14;
-        noise_level+= 14.0f;
-    }
-    if (params_band_cur_pre_get()){
-        db -= 14;
-        noise_level -= 14.0f;
-    }
+/**
+ * Calibrated reading, dB
+ */
+void meter_update(float db, float beta) {
     if (db < min_db) {
         db = min_db;
     } else if (db > max_db) {
@@ -175,3 +186,10 @@ void meter_update(int16_t db, float beta) {
     meter_db = meter_db * beta + db * (1.0f - beta);
     event_send(obj, LV_EVENT_REFRESH, NULL);
 }
+
+/**
+ * Noise floor in the channel bandwidth from DSP, calibrated like reading
+ */
+void meter_update_noise(float db) {
+    lpf(&noise_level, db, 0.9f, S_MIN);
+}
@@ -25,4 +25,5 @@
 #define S9_40   (S9 + 40)
 
 lv_obj_t * meter_init(lv_obj_t * parent);
-void meter_update(int16_t db, float beta);
+void meter_update(float db, float beta);
+void meter_update_noise(float db);
@@ -72,7 +72,7 @@ void mfk_update(int16_t diff, bool voice) {
         case MFK_SPECTRUM_FACTOR:
             i = params_current_mode_spectrum_factor_get();
             if (diff != 0) {
-                i = params_current_mode_spectrum_factor_set(i + diff);
+                i = params_current_mode_spectrum_factor_set((diff > 0) ? i * 2 : i / 2);
                 lv_msg_send(MSG_SPECTRUM_ZOOM_CHANGED, &i);
             }
             msg_update_text_fmt("#%3X Spectrum zoom: x%i", color, i);
@@ -99,7 +99,7 @@ void mfk_update(int16_t diff, bool voice) {
 
                 dsp_set_spectrum_beta(params.spectrum_beta / 100.0f);
             }
-            msg_update_text_fmt("#%3X Spectrum beta: %i", color, params.spectrum_beta);
+            msg_update_text_fmt("#%3X Spectrum beta: %i (%i ms)", color, params.spectrum_beta, (int) dsp_get_spectrum_avg_ms());
 
             if (diff) {
                 voice_say_int("Spectrum beta", params.spectrum_beta);
@@ -326,6 +326,22 @@ void mfk_update(int16_t diff, bool voice) {
             }
             break;
 
+        case MFK_WATERFALL_HISTORY:
+            i = waterfall_history_change(diff);
+
+            if (i) {
+                msg_update_text_fmt("#%3X Waterfall: %i s ago", color, i);
+            } else {
+                msg_update_text_fmt("#%3X Waterfall: live", color);
+            }
+
+            if (diff) {
+                voice_say_int("Waterfall history", i);
+            } else if (voice) {
+                voice_say_text_fmt("Waterfall history");
+            }
+            break;
+
         case MFK_DNF:
             b = radio_change_dnf(diff);
             msg_update_text_fmt("#%3X DNF: %s", color, b ? "On" : "Off");
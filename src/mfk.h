@@ -55,6 +55,8 @@ typedef enum {
     MFK_RIT,
     MFK_XIT,
 
+    MFK_WATERFALL_HISTORY,
+
     MFK_LAST,
 
     /* APPs */
@@ -35,6 +35,8 @@ typedef struct {
     params_uint16_t rfg;
     struct {char x[64]; bool dirty;} label;
 
+    params_int16_t  smeter_cal[SMETER_CAL_COUNT];
+
     params_vfo_t    vfo_x[2];
 } params_band_t;
 
@@ -62,12 +64,22 @@ static params_band_t params_band = {
     .grid_min           = {.x=-121, .dirty=false},
     .grid_max           = {.x=-73, .dirty=false},
     .rfg                = {.x=63, .dirty=false},
+
+    .smeter_cal         = {
+        [SMETER_CAL_BASE]   = {.x=0, .dirty=false},
+        [SMETER_CAL_PRE]    = {.x=14, .dirty=false},
+        [SMETER_CAL_ATT]    = {.x=14, .dirty=false}
+    },
 };
 
+static const int16_t    smeter_cal_default[SMETER_CAL_COUNT] = { 0, 14, 14 };
+static const char       *smeter_cal_name[SMETER_CAL_COUNT] = { "smeter_cal", "smeter_cal_pre", "smeter_cal_att" };
+
 static sqlite3_stmt     *write_mb_stmt;
 
 static void params_mb_save(uint16_t id);
 static void params_mb_load(sqlite3_stmt *stmt);
+static void params_band_cal_load(uint16_t id);
 
 /* Memory/Bands params */
 
@@ -98,6 +110,41 @@ void params_band_load(uint16_t id) {
 
     sqlite3_bind_int(stmt, 1, id);
     params_mb_load(stmt);
+    params_band_cal_load(id);
+}
+
+/* Calibration is a band property, memory channels do not have it */
+
+static void params_band_cal_load(uint16_t id) {
+    sqlite3_stmt *stmt;
+
+    /* Do not inherit it from previous band */
+    for (uint8_t i = 0; i < SMETER_CAL_COUNT; i++) {
+        params_band.smeter_cal[i].x = smeter_cal_default[i];
+        params_band.smeter_cal[i].dirty = false;
+    }
+
+    int rc = sqlite3_prepare_v2(db, "SELECT name,val FROM band_params WHERE bands_id = ? AND name LIKE 'smeter_cal%'", -1, &stmt, 0);
+
+    if (rc != SQLITE_OK) {
+        LV_LOG_ERROR("Prepare");
+        return;
+    }
+
+    sqlite3_bind_int(stmt, 1, id);
+
+    while (sqlite3_step(stmt) == SQLITE_ROW) {
+        const char *name = sqlite3_column_text(stmt, 0);
+
+        for (uint8_t i = 0; i < SMETER_CAL_COUNT; i++) {
+            if (strcmp(name, smeter_cal_name[i]) == 0) {
+                params_band.smeter_cal[i].x = sqlite3_column_int(stmt, 1);
+                break;
+            }
+        }
+    }
+
+    sqlite3_finalize(stmt);
 }
 
 static void params_mb_load(sqlite3_stmt *stmt) {
@@ -200,6 +247,12 @@ void params_band_save(uint16_t id) {
     sqlite3_prepare_v2(db, "INSERT INTO band_params(bands_id, name, val) VALUES(?, ?, ?)", -1, &write_mb_stmt, 0);
 
     params_mb_save(id);
+
+    for (uint8_t i = 0; i < SMETER_CAL_COUNT; i++) {
+        if (params_band.smeter_cal[i].dirty)
+            params_mb_write_int(id, smeter_cal_name[i], params_band.smeter_cal[i].x, &params_band.smeter_cal[i].dirty);
+    }
+
     sql_query_exec("COMMIT");
     sqlite3_finalize(write_mb_stmt);
 }
@@ -562,3 +615,33 @@ int16_t params_band_grid_max_set(int16_t db)
 
     return params_band.grid_max.x;
 }
+
+int16_t params_band_smeter_cal_get(smeter_cal_t cal)
+{
+    return params_band.smeter_cal[cal].x;
+}
+
+int16_t params_band_smeter_cal_set(smeter_cal_t cal, int16_t db)
+{
+    db = limit(db, -40, 40);
+    if (params_band.smeter_cal[cal].x != db) {
+        params_lock();
+        params_band.smeter_cal[cal].x = db;
+        params_band.smeter_cal[cal].dirty = true;
+        params_unlock(NULL);
+    }
+    return params_band.smeter_cal[cal].x;
+}
+
+float params_band_smeter_offset_get()
+{
+    float offset = params_band.smeter_cal[SMETER_CAL_BASE].x;
+
+    if (params_band_cur_pre_get()) {
+        offset -= params_band.smeter_cal[SMETER_CAL_PRE].x;
+    }
+    if (params_band_cur_att_get()) {
+        offset += params_band.smeter_cal[SMETER_CAL_ATT].x;
+    }
+    return offset;
+}
@@ -10,6 +10,15 @@
 #include <stdbool.h>
 #include <aether_radio/x6100_control/control.h>
 
+/* S-meter calibration values of the band, dB */
+typedef enum {
+    SMETER_CAL_BASE = 0,    /* Offset of reading */
+    SMETER_CAL_PRE,         /* Preamp gain */
+    SMETER_CAL_ATT,         /* Attenuator loss */
+
+    SMETER_CAL_COUNT
+} smeter_cal_t;
+
 void params_memory_load(uint16_t id);
 void params_memory_save(uint16_t id);
 
@@ -66,6 +75,14 @@ int16_t params_band_grid_min_set(int16_t db);
 int16_t params_band_grid_max_get();
 int16_t params_band_grid_max_set(int16_t db);
 
+int16_t params_band_smeter_cal_get(smeter_cal_t cal);
+int16_t params_band_smeter_cal_set(smeter_cal_t cal, int16_t db);
+
+/**
+ * Correction of S-meter reading for current preamp/attenuator
+ */
+float params_band_smeter_offset_get();
+
 
 void params_band_vfo_clone();
 
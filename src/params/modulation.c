@@ -267,7 +267,8 @@ int16_t params_mode_spectrum_factor_get(x6100_mode_t mode) {
 int16_t params_mode_spectrum_factor_set(x6100_mode_t mode, int16_t val) {
     params_int16_t *param = &get_params_by_mode(mode)->spectrum_factor;
     params_lock();
-    if ((val != param->x) & (val >= 1) & (val <= 8)) {
+    /* Power of 2 from 1 to 16, see spectrum levels in dsp.c */
+    if ((val != param->x) & (val >= 1) & (val <= 16) & ((val & (val - 1)) == 0)) {
         param->x = val;
         param->dirty = true;
     }
@@ -387,7 +388,12 @@ static void params_mode_load() {
         } else if (strcmp(name, "freq_step") == 0) {
             mode_params->freq_step.x = sqlite3_column_int(stmt, 2);
         } else if (strcmp(name, "spectrum_factor") == 0) {
-            mode_params->spectrum_factor.x = sqlite3_column_int(stmt, 2);
+            int32_t factor = sqlite3_column_int(stmt, 2);
+
+            mode_params->spectrum_factor.x = 1;
+            while ((mode_params->spectrum_factor.x < 16) && (mode_params->spectrum_factor.x * 2 <= factor)) {
+                mode_params->spectrum_factor.x *= 2;
+            }
         }
     }
     sqlite3_finalize(stmt);
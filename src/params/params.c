@@ -37,11 +37,17 @@ params_t params = {
     .spectrum_peak_speed    = 0.5f,
     .spectrum_auto_min      = { .x = true,  .name = "spectrum_auto_min",        .voice = "Auto minimum of spectrum" },
     .spectrum_auto_max      = { .x = true,  .name = "spectrum_auto_max",        .voice = "Auto maximum of spectrum" },
+    .spectrum_power_avg     = { .x = false, .name = "spectrum_power_avg",       .voice = "Spectrum power averaging" },
+    .spectrum_min_hold      = { .x = false, .name = "spectrum_min_hold",        .voice = "Spectrum minimum hold" },
+    .spectrum_nfft          = { .x = 0, .min = 0, .max = 2, .name = "spectrum_nfft" },
     .waterfall_auto_min     = { .x = true,  .name = "waterfall_auto_min",       .voice = "Auto minimum of waterfall" },
     .waterfall_auto_max     = { .x = true,  .name = "waterfall_auto_max",       .voice = "Auto maximum of waterfall" },
     .waterfall_smooth_scroll= { .x = true,  .name = "waterfall_smooth_scroll",  .voice = "Waterfall smooth scroll"},
     .waterfall_center_line  = { .x = true,  .name = "waterfall_center_line",    .voice = "Waterfall center line"},
     .waterfall_zoom         = { .x = true,  .name = "waterfall_zoom",           .voice = "Waterfall zoom"},
+    .waterfall_nfft         = { .x = 0, .min = 0, .max = 3, .name = "waterfall_nfft" },
+    .governor_policy        = { .x = 1, .min = 0, .max = 2, .name = "governor_policy" },
+    .governor_readout       = { .x = false, .name = "governor_readout",         .voice = "Load readout" },
     .mag_freq               = { .x = false,  .name = "mag_freq",                 .voice = "Magnification of frequency" },
     .mag_info               = { .x = true,  .name = "mag_info",                 .voice = "Magnification of info" },
     .mag_alc                = { .x = true,  .name = "mag_alc",                  .voice = "Magnification of A L C" },
@@ -149,6 +155,8 @@ params_t params = {
     .wifi_enabled           = { .x = false, .name="wifi_enabled" },
 
     .theme                  = { .x = THEME_SIMPLE, .name="theme"},
+
+    .iq_pretrigger          = { .x = 0, .min = 0, .max = 3, .name = "iq_pretrigger" },
 };
 
 transverter_t params_transverter[TRANSVERTER_NUM] = {
@@ -388,11 +396,17 @@ static bool params_load() {
         if (params_load_bool(&params.mag_alc, name, i)) continue;
         if (params_load_bool(&params.spectrum_auto_min, name, i)) continue;
         if (params_load_bool(&params.spectrum_auto_max, name, i)) continue;
+        if (params_load_bool(&params.spectrum_power_avg, name, i)) continue;
+        if (params_load_bool(&params.spectrum_min_hold, name, i)) continue;
+        if (params_load_uint8(&params.spectrum_nfft, name, i)) continue;
         if (params_load_bool(&params.waterfall_auto_min, name, i)) continue;
         if (params_load_bool(&params.waterfall_auto_max, name, i)) continue;
         if (params_load_bool(&params.waterfall_smooth_scroll, name, i)) continue;
         if (params_load_bool(&params.waterfall_center_line, name, i)) continue;
         if (params_load_bool(&params.waterfall_zoom, name, i)) continue;
+        if (params_load_uint8(&params.waterfall_nfft, name, i)) continue;
+        if (params_load_uint8(&params.governor_policy, name, i)) continue;
+        if (params_load_bool(&params.governor_readout, name, i)) continue;
         if (params_load_bool(&params.spmode, name, i)) continue;
         if (params_load_bool(&params.ft8_auto, name, i)) continue;
         if (params_load_float(&params.ft8_output_gain_offset, name, f)) continue;
@@ -412,6 +426,7 @@ static bool params_load() {
         if (params_load_str(&params.callsign, name, t)) continue;
         if (params_load_bool(&params.wifi_enabled, name, i)) continue;
         if (params_load_uint8(&params.theme, name, i)) continue;
+        if (params_load_uint8(&params.iq_pretrigger, name, i)) continue;
     }
 
     sqlite3_finalize(stmt);
@@ -565,11 +580,17 @@ static void params_save() {
     params_save_bool(&params.mag_alc);
     params_save_bool(&params.spectrum_auto_min);
     params_save_bool(&params.spectrum_auto_max);
+    params_save_bool(&params.spectrum_power_avg);
+    params_save_bool(&params.spectrum_min_hold);
+    params_save_uint8(&params.spectrum_nfft);
     params_save_bool(&params.waterfall_auto_min);
     params_save_bool(&params.waterfall_auto_max);
     params_save_bool(&params.waterfall_smooth_scroll);
     params_save_bool(&params.waterfall_center_line);
     params_save_bool(&params.waterfall_zoom);
+    params_save_uint8(&params.waterfall_nfft);
+    params_save_uint8(&params.governor_policy);
+    params_save_bool(&params.governor_readout);
     params_save_bool(&params.spmode);
     params_save_bool(&params.ft8_auto);
     params_save_float(&params.ft8_output_gain_offset);
@@ -579,6 +600,7 @@ static void params_save() {
     params_save_str(&params.callsign);
     params_save_bool(&params.wifi_enabled);
     params_save_uint8(&params.theme);
+    params_save_uint8(&params.iq_pretrigger);
 
     sql_query_exec("COMMIT");
 }
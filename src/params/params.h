@@ -138,11 +138,17 @@ typedef struct {
     bool                spectrum_filled;
     params_bool_t       spectrum_auto_min;
     params_bool_t       spectrum_auto_max;
+    params_bool_t       spectrum_power_avg;
+    params_bool_t       spectrum_min_hold;
+    params_uint8_t      spectrum_nfft;      /* Zoomed spectrum FFT, 1024 << x */
     params_bool_t       waterfall_auto_min;
     params_bool_t       waterfall_auto_max;
     params_bool_t       waterfall_smooth_scroll;
     params_bool_t       waterfall_center_line;
     params_bool_t       waterfall_zoom;
+    params_uint8_t      waterfall_nfft;     /* Waterfall FFT, 1024 << x */
+    params_uint8_t      governor_policy;
+    params_bool_t       governor_readout;
     params_bool_t       mag_freq;
     params_bool_t       mag_info;
     params_bool_t       mag_alc;
@@ -242,6 +248,10 @@ typedef struct {
 
     params_uint8_t       theme;
 
+    /* IQ recorder */
+
+    params_uint8_t      iq_pretrigger;
+
     /* durty flags */
 
     struct {
@@ -16,6 +16,7 @@
 #include "dialog_swrscan.h"
 #include "cw.h"
 #include "pubsub_ids.h"
+#include "iq_record.h"
 
 #include "cat.h"
 
@@ -86,7 +87,13 @@ bool radio_tick() {
             delay = 0;
             clock_update_power(pack->vext * 0.1f, pack->vbat*0.1f, pack->batcap, pack->flag.charging);
         }
-        dsp_samples(((void *)pack) + offsetof(x6100_flow_t, samples), RADIO_SAMPLES, pack->flag.tx);
+        float complex *samples = ((void *)pack) + offsetof(x6100_flow_t, samples);
+
+        iq_record_put(samples, RADIO_SAMPLES, pack->flag.tx);
+
+        if (!iq_replay_owns_dsp()) {
+            dsp_samples(samples, RADIO_SAMPLES, pack->flag.tx);
+        }
 
         switch (state) {
             case RADIO_RX:
@@ -9,17 +9,24 @@
 #include <time.h>
 #include <sys/time.h>
 #include <sndfile.h>
+#include <pthread.h>
 
 #include "audio.h"
+#include "audio_bus.h"
 #include "dialog_recorder.h"
 #include "recorder.h"
 #include "msg.h"
 #include "params/params.h"
 
+#define QUEUE   64  /* Blocks, ~1.5 s of SD card stall, half of the bus pool */
+
 char            *recorder_path = "/mnt/rec";
 
-static bool     on = false;
-static SNDFILE  *file = NULL;
+static bool             on = false;
+static SNDFILE          *file = NULL;
+static pthread_mutex_t  file_mux = PTHREAD_MUTEX_INITIALIZER;
+static audio_bus_sub_t  sub = NULL;
+static uint32_t         drops;
 
 static bool create_file() {
     SF_INFO sfinfo;
@@ -53,19 +60,47 @@ static bool create_file() {
     return true;
 }
 
+static void audio_cb(const audio_block_t *block, void *user) {
+    recorder_put_audio_samples(block->n, block->raw);
+}
+
+void recorder_init() {
+    sub = audio_bus_subscribe(audio_cb, NULL, QUEUE);
+    audio_bus_set_enabled(sub, false);
+}
+
 void recorder_set_on(bool x) {
     if (x) {
-        if (!create_file()) {
+        pthread_mutex_lock(&file_mux);
+        bool ok = create_file();
+        pthread_mutex_unlock(&file_mux);
+
+        if (!ok) {
             msg_update_text_fmt("Problem with create file");
             return;
         } else {
             msg_update_text_fmt("Recorder is on");
         }
         on = true;
+        drops = audio_bus_drops(sub);
+        audio_bus_set_enabled(sub, true);
     } else {
-        msg_update_text_fmt("Recorder is off");
         on = false;
+        audio_bus_set_enabled(sub, false);
+        drops = audio_bus_drops(sub) - drops;
+
+        if (drops) {
+            LV_LOG_WARN("Recorder lost %u audio blocks", drops);
+            msg_update_text_fmt("Recorder is off, %u audio blocks lost", drops);
+        } else {
+            msg_update_text_fmt("Recorder is off");
+        }
+
+        /* Encoder worker may still write queued blocks */
+        pthread_mutex_lock(&file_mux);
         sf_close(file);
+        file = NULL;
+        pthread_mutex_unlock(&file_mux);
     }
 
     dialog_recorder_set_on(on);
@@ -76,5 +111,11 @@ bool recorder_is_on() {
 }
 
 void recorder_put_audio_samples(size_t nsamples, int16_t *samples) {
-    sf_write_short(file, samples, nsamples);
+    pthread_mutex_lock(&file_mux);
+
+    if (file) {
+        sf_write_short(file, samples, nsamples);
+    }
+
+    pthread_mutex_unlock(&file_mux);
 }
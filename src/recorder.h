@@ -13,6 +13,11 @@
 
 extern char *recorder_path;
 
+/**
+ * Subscribe to captured audio, encoding is done on own worker thread
+ */
+void recorder_init();
+
 void recorder_set_on(bool on);
 bool recorder_is_on();
 void recorder_put_audio_samples(size_t nsamples, int16_t *samples);
@@ -11,6 +11,7 @@
 #include "params/params.h"
 #include "pannel.h"
 #include "util.h"
+#include "audio_bus.h"
 
 #include "lvgl/lvgl.h"
 
@@ -115,10 +116,17 @@ static void update() {
     pthread_mutex_unlock(&rtty_mux);
 }
 
+static void audio_cb(const audio_block_t *block, void *user) {
+    if (state == RTTY_RX) {
+        rtty_put_audio_samples(block->n, block->analytic);
+    }
+}
+
 void rtty_init() {
     pthread_mutex_init(&rtty_mux, NULL);
 
     init();
+    audio_bus_subscribe(audio_cb, NULL, 0);
 }
 
 static char baudot_decoder(uint8_t c) {
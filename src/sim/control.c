@@ -0,0 +1,270 @@
+/*
+ *  SPDX-License-Identifier: LGPL-2.1-or-later
+ *
+ *  Xiegu X6100 LVGL GUI
+ *
+ *  Copyright (c) 2024 Georgy Dyuldin aka R2RFE
+ */
+
+/*
+ * x6100_control and x6100_gpio API for simulator. Commands that affect
+ * flow (frequency, mode, RF path, TX, ATU) are kept in sim state, the rest
+ * are accepted and ignored.
+ */
+
+#include "sim.h"
+
+#include <aether_radio/x6100_control/low/gpio.h>
+
+#include <stdio.h>
+#include <time.h>
+
+#define WITH_SIM_LOCK(fn) pthread_mutex_lock(&sim.mux); fn; pthread_mutex_unlock(&sim.mux);
+
+sim_state_t sim = {
+    .mux            = PTHREAD_MUTEX_INITIALIZER,
+    .freq           = { 14074000, 14074000 },
+    .mode           = { x6100_mode_usb_dig, x6100_mode_usb_dig },
+    .vfo            = X6100_VFO_A,
+    .filter_low     = 50,
+    .filter_high    = 2950,
+    .key_tone       = 700,
+    .txpwr          = 5.0f,
+};
+
+uint64_t sim_time_us() {
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+
+    return (uint64_t) now.tv_sec * 1000000L + now.tv_nsec / 1000L;
+}
+
+uint32_t sim_atu_network(uint32_t freq) {
+    /* Any stable value per 50 kHz segment */
+    return ((freq / 50000) * 2654435761u) & 0x00FFFFFF;
+}
+
+/* Control */
+
+bool x6100_control_init() {
+    sim_scene_init();
+    fprintf(stderr, "x6100 simulator: control ready\n");
+
+    return true;
+}
+
+void x6100_control_idle() {
+}
+
+bool x6100_control_cmd(x6100_cmd_enum_t cmd, uint32_t arg) {
+    pthread_mutex_lock(&sim.mux);
+
+    switch (cmd) {
+        case x6100_filter1_low:
+        case x6100_filter2_low:
+            sim.filter_low = (int32_t) arg;
+            break;
+
+        case x6100_filter1_high:
+        case x6100_filter2_high:
+            sim.filter_high = (int32_t) arg;
+            break;
+
+        case x6100_atu_network:
+            sim.atu_network = arg;
+            break;
+
+        default:
+            break;
+    }
+
+    pthread_mutex_unlock(&sim.mux);
+
+    return true;
+}
+
+void x6100_control_vfo_mode_set(x6100_vfo_t vfo, x6100_mode_t mode) {
+    WITH_SIM_LOCK(sim.mode[vfo] = mode);
+}
+
+void x6100_control_vfo_freq_set(x6100_vfo_t vfo, uint32_t freq) {
+    WITH_SIM_LOCK(sim.freq[vfo] = freq);
+}
+
+void x6100_control_vfo_agc_set(x6100_vfo_t vfo, x6100_agc_t agc) {
+}
+
+void x6100_control_vfo_att_set(x6100_vfo_t vfo, x6100_att_t att) {
+    WITH_SIM_LOCK(sim.att[vfo] = att);
+}
+
+void x6100_control_vfo_pre_set(x6100_vfo_t vfo, x6100_pre_t pre) {
+    WITH_SIM_LOCK(sim.pre[vfo] = pre);
+}
+
+void x6100_control_vfo_set(x6100_vfo_t vfo) {
+    WITH_SIM_LOCK(sim.vfo = vfo);
+}
+
+void x6100_control_split_set(bool on) {
+}
+
+void x6100_control_rxvol_set(uint8_t x) {
+}
+
+void x6100_control_rfg_set(uint8_t rfg) {
+}
+
+void x6100_control_sql_set(uint8_t sql) {
+}
+
+void x6100_control_atu_set(bool on) {
+    WITH_SIM_LOCK(sim.atu_on = on);
+}
+
+void x6100_control_atu_tune(bool on) {
+    pthread_mutex_lock(&sim.mux);
+
+    sim.atu_tune = on;
+    sim.atu_start = sim_time_us();
+
+    pthread_mutex_unlock(&sim.mux);
+}
+
+void x6100_control_txpwr_set(float pwr) {
+    WITH_SIM_LOCK(sim.txpwr = pwr);
+}
+
+void x6100_control_charger_set(bool on) {
+    WITH_SIM_LOCK(sim.charger = on);
+}
+
+void x6100_control_bias_drive_set(uint16_t x) {
+}
+
+void x6100_control_bias_final_set(uint16_t x) {
+}
+
+void x6100_control_key_speed_set(uint8_t wpm) {
+}
+
+void x6100_control_key_mode_set(x6100_key_mode_t mode) {
+}
+
+void x6100_control_iambic_mode_set(x6100_iambic_mode_t mode) {
+}
+
+void x6100_control_key_tone_set(uint16_t tone) {
+    WITH_SIM_LOCK(sim.key_tone = tone);
+}
+
+void x6100_control_key_vol_set(uint16_t vol) {
+}
+
+void x6100_control_key_train_set(bool train) {
+}
+
+void x6100_control_qsk_time_set(uint16_t time) {
+}
+
+void x6100_control_key_ratio_set(float ratio) {
+}
+
+void x6100_control_mic_set(x6100_mic_sel_t mic) {
+}
+
+void x6100_control_hmic_set(uint8_t level) {
+}
+
+void x6100_control_imic_set(uint8_t level) {
+}
+
+void x6100_control_ptt_set(bool on) {
+    WITH_SIM_LOCK(sim.ptt = on);
+}
+
+void x6100_control_modem_set(bool on) {
+    WITH_SIM_LOCK(sim.modem = on);
+}
+
+void x6100_control_swrscan_set(bool on) {
+    WITH_SIM_LOCK(sim.swrscan = on);
+}
+
+void x6100_control_record_set(bool on) {
+}
+
+void x6100_control_spmode_set(bool phone) {
+}
+
+void x6100_control_dnf_set(bool on) {
+}
+
+void x6100_control_dnf_center_set(uint16_t freq) {
+}
+
+void x6100_control_dnf_width_set(uint16_t hz) {
+}
+
+void x6100_control_nb_set(bool on) {
+}
+
+void x6100_control_nb_level_set(uint8_t level) {
+}
+
+void x6100_control_nb_width_set(uint8_t hz) {
+}
+
+void x6100_control_nr_set(bool on) {
+}
+
+void x6100_control_nr_level_set(uint8_t level) {
+}
+
+void x6100_control_agc_hang_set(bool on) {
+}
+
+void x6100_control_agc_knee_set(int8_t db) {
+}
+
+void x6100_control_agc_slope_set(uint8_t db) {
+}
+
+void x6100_control_agc_time_set(uint16_t ms) {
+}
+
+void x6100_control_vox_set(bool on) {
+}
+
+void x6100_control_vox_ag_set(uint8_t level) {
+}
+
+void x6100_control_vox_delay_set(uint16_t delay) {
+}
+
+void x6100_control_vox_gain_set(uint8_t level) {
+}
+
+void x6100_control_linein_set(uint8_t level) {
+}
+
+void x6100_control_lineout_set(uint8_t level) {
+}
+
+void x6100_control_poweroff() {
+    fprintf(stderr, "x6100 simulator: power off\n");
+}
+
+/* GPIO */
+
+bool x6100_gpio_init() {
+    return true;
+}
+
+void x6100_gpio_set(x6100_pin_t pin, int value) {
+    if (pin == x6100_pin_morse_key) {
+        /* Active low */
+        WITH_SIM_LOCK(sim.key = (value == 0));
+    }
+}
@@ -0,0 +1,45 @@
+/*
+ *  SPDX-License-Identifier: LGPL-2.1-or-later
+ *
+ *  Xiegu X6100 LVGL GUI
+ *
+ *  Copyright (c) 2024 Georgy Dyuldin aka R2RFE
+ */
+
+#include "fb.h"
+
+#include <string.h>
+
+/* Physical orientation of X6100 panel */
+#define FB_WIDTH    480
+#define FB_HEIGHT   800
+
+static lv_color_t   fb[FB_WIDTH * FB_HEIGHT];
+
+void sim_fb_init() {
+    memset(fb, 0, sizeof(fb));
+}
+
+void sim_fb_flush(lv_disp_drv_t *drv, const lv_area_t *area, lv_color_t *color_p) {
+    int32_t x1 = LV_MAX(area->x1, 0);
+    int32_t x2 = LV_MIN(area->x2, FB_WIDTH - 1);
+    int32_t y1 = LV_MAX(area->y1, 0);
+    int32_t y2 = LV_MIN(area->y2, FB_HEIGHT - 1);
+    int32_t w = lv_area_get_width(area);
+
+    if (x1 <= x2) {
+        for (int32_t y = y1; y <= y2; y++) {
+            lv_color_t *src = color_p + (y - area->y1) * w + (x1 - area->x1);
+
+            memcpy(&fb[y * FB_WIDTH + x1], src, (x2 - x1 + 1) * sizeof(lv_color_t));
+        }
+    }
+
+    lv_disp_flush_ready(drv);
+}
+
+uint32_t * sim_fb_page(uint32_t *stride) {
+    *stride = FB_WIDTH;
+
+    return (uint32_t *) fb;
+}
@@ -0,0 +1,24 @@
+/*
+ *  SPDX-License-Identifier: LGPL-2.1-or-later
+ *
+ *  Xiegu X6100 LVGL GUI
+ *
+ *  Copyright (c) 2024 Georgy Dyuldin aka R2RFE
+ */
+
+#pragma once
+
+#include "lvgl/lvgl.h"
+
+/**
+ * Memory framebuffer for simulator, replacement of fbdev driver.
+ * Flushed areas are copied, so render cost is the same as on the radio
+ */
+
+void sim_fb_init();
+void sim_fb_flush(lv_disp_drv_t *drv, const lv_area_t *area, lv_color_t *color_p);
+
+/**
+ * Direct access to native pixels, stride in pixels
+ */
+uint32_t * sim_fb_page(uint32_t *stride);
@@ -0,0 +1,160 @@
+/*
+ *  SPDX-License-Identifier: LGPL-2.1-or-later
+ *
+ *  Xiegu X6100 LVGL GUI
+ *
+ *  Copyright (c) 2024 Georgy Dyuldin aka R2RFE
+ */
+
+/*
+ * x6100_flow API for simulator. Packets are produced at the radio rate
+ * (512 samples at 100 kHz), with scene IQ in RX and TX/ATU/SWR telemetry
+ * derived from control state.
+ */
+
+#include "sim.h"
+
+#include <aether_radio/x6100_control/low/flow.h>
+
+#include <math.h>
+#include <stddef.h>
+#include <string.h>
+#include <time.h>
+
+#define PACKET_SAMPLES  (sizeof(((x6100_flow_t *) 0)->samples) / sizeof(float complex))
+#define PACKET_US       ((uint64_t) PACKET_SAMPLES * 1000000 / SIM_SAMPLE_RATE)
+#define MAX_LAG         64          /* Packets, skip them after stall (debugger etc) */
+#define ATU_TUNE_US     1500000
+
+static uint64_t     start_us = 0;
+static uint64_t     wall_start_us;
+static uint64_t     packets;
+static double       tx_phase = 0.0;
+
+/**
+ * Model of multiband antenna, resonance in the middle of each band
+ */
+static float antenna_swr(uint32_t freq) {
+    static const uint32_t resonance[] = {
+        1840000, 3650000, 5360000, 7100000, 10120000, 14175000,
+        18100000, 21200000, 24940000, 28500000, 50150000
+    };
+
+    float swr = 9.9f;
+
+    for (size_t i = 0; i < sizeof(resonance) / sizeof(resonance[0]); i++) {
+        float d = fabsf((float) freq - resonance[i]) / (resonance[i] * 0.01f);
+        float x = 1.2f + 3.0f * d;
+
+        if (x < swr) {
+            swr = x;
+        }
+    }
+    return swr;
+}
+
+static void render_tx(float complex *samples, float freq) {
+    double step = 2.0 * M_PI * freq / SIM_SAMPLE_RATE;
+
+    for (uint16_t i = 0; i < PACKET_SAMPLES; i++) {
+        samples[i] = 0.1f * cexpf(I * tx_phase);
+        tx_phase = fmod(tx_phase + step, 2.0 * M_PI);
+    }
+}
+
+bool x6100_flow_init() {
+    start_us = 0;
+    return true;
+}
+
+void x6100_flow_restart() {
+    start_us = 0;
+}
+
+bool x6100_flow_read(x6100_flow_t *pack) {
+    uint64_t now = sim_time_us();
+
+    if (start_us == 0) {
+        struct timespec wall;
+
+        clock_gettime(CLOCK_REALTIME, &wall);
+
+        start_us = now;
+        wall_start_us = (uint64_t) wall.tv_sec * 1000000L + wall.tv_nsec / 1000L;
+        packets = 0;
+    }
+
+    uint64_t due = (now - start_us) / PACKET_US;
+
+    if (packets >= due) {
+        return false;
+    }
+
+    if (due - packets > MAX_LAG) {
+        packets = due - 1;
+    }
+
+    /* Snapshot of control state */
+
+    pthread_mutex_lock(&sim.mux);
+
+    x6100_vfo_t     vfo = sim.vfo;
+    uint32_t        freq = sim.freq[vfo];
+    x6100_mode_t    mode = sim.mode[vfo];
+    float           gain_db = (sim.pre[vfo] ? 10.0f : 0.0f) - (sim.att[vfo] ? 12.0f : 0.0f);
+    bool            voice = sim.ptt || sim.modem;
+    bool            tx = voice || sim.key || sim.swrscan;
+    bool            atu_done = false;
+
+    if (sim.atu_tune) {
+        if (now - sim.atu_start < ATU_TUNE_US) {
+            tx = true;
+        } else {
+            atu_done = true;
+        }
+    }
+
+    float swr = antenna_swr(freq);
+
+    if (sim.atu_on && sim.atu_network == sim_atu_network(freq)) {
+        swr = 1.0f + (swr - 1.0f) * 0.05f;
+    }
+
+    float       txpwr = sim.txpwr;
+    uint16_t    key_tone = sim.key_tone;
+    bool        charger = sim.charger;
+
+    pthread_mutex_unlock(&sim.mux);
+
+    /* Packet */
+
+    memset(pack, 0, sizeof(x6100_flow_t));
+
+    float complex *samples = ((void *)pack) + offsetof(x6100_flow_t, samples);
+
+    if (tx) {
+        float tone = (mode == x6100_mode_cwr || mode == x6100_mode_lsb || mode == x6100_mode_lsb_dig) ? -1.0f : 1.0f;
+
+        render_tx(samples, tone * (voice ? 1500.0f : key_tone));
+
+        pack->tx_power = txpwr * 10.0f / (1.0f + (swr - 1.0f) * 0.1f);
+        pack->vswr = swr * 10.0f;
+        pack->alc_level = voice ? 15 : 0;
+    } else {
+        sim_scene_render(samples, PACKET_SAMPLES, freq, powf(10.0f, gain_db / 20.0f),
+                         wall_start_us + packets * PACKET_US);
+    }
+
+    pack->flag.tx = tx;
+    pack->flag.atu_status = atu_done;
+    pack->flag.charging = charger;
+    pack->atu_params = atu_done ? sim_atu_network(freq) : 0;
+    pack->vext = 138;
+    pack->vbat = 82;
+    pack->batcap = 90;
+    pack->hkey = 0;
+
+    packets++;
+
+    return true;
+}
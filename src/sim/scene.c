@@ -0,0 +1,333 @@
+/*
+ *  SPDX-License-Identifier: LGPL-2.1-or-later
+ *
+ *  Xiegu X6100 LVGL GUI
+ *
+ *  Copyright (c) 2024 Georgy Dyuldin aka R2RFE
+ */
+
+/*
+ * Simulator RF scene. Loaded from file in X6100_SIM_SCENE, one item per line,
+ * levels in dB relative to unit amplitude:
+ *
+ *   noise <db>                     Total noise power of 100 kHz flow
+ *   tone  <freq> <db>
+ *   cw    <freq> <db> <wpm> <text>  Repeated text
+ *   ft8   <freq> <db> <text>        Each 15 s slot
+ *
+ * FT8 signals have correct Costas sync and timing, payload symbols are
+ * pseudo-random from text, so they load sync search but are not decoded.
+ */
+
+#include "sim.h"
+
+#include <aether_radio/x6100_control/low/flow.h>
+
+#include <ctype.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define MAX_SIGNALS     64
+#define HALF_SPAN       (SIM_SAMPLE_RATE / 2)
+
+#define FT8_SYMBOLS     79
+#define FT8_SYMBOL_US   160000
+#define FT8_SLOT_US     15000000
+#define FT8_START_US    500000
+#define FT8_SPACING     6.25f
+
+typedef enum {
+    SIGNAL_TONE = 0,
+    SIGNAL_CW,
+    SIGNAL_FT8
+} signal_type_t;
+
+typedef struct {
+    signal_type_t   type;
+    uint32_t        freq;
+    float           amp;
+    float complex   phasor;
+    float           env;
+
+    /* CW, one item per dot */
+    uint8_t         *keying;
+    size_t          keying_len;
+    uint32_t        dot_us;
+
+    /* FT8 */
+    uint8_t         tones[FT8_SYMBOLS];
+} signal_t;
+
+static signal_t     signals[MAX_SIGNALS];
+static size_t       signals_count = 0;
+static float        noise_amp = 0.0f;
+static uint32_t     rnd = 0x9E3779B9;
+
+static const char *default_scene =
+    "noise -95\n"
+    "ft8 7074600 -95 CQ R2RFE KO85\n"
+    "ft8 7075300 -105 CQ K1ABC FN42\n"
+    "ft8 14074800 -90 CQ DL1ABC JO62\n"
+    "ft8 14075500 -110 R1CBU K1ABC -12\n"
+    "ft8 14076200 -100 CQ DX JA1XYZ PM95\n"
+    "cw 7025000 -85 22 CQ CQ DE R2RFE R2RFE K\n"
+    "cw 14030000 -95 18 TEST DE K1ABC\n"
+    "cw 14032500 -80 28 5NN TU\n"
+    "tone 14060000 -75\n"
+    "tone 14100000 -60\n";
+
+static const char *morse[128] = {
+    ['A'] = ".-",    ['B'] = "-...",  ['C'] = "-.-.",  ['D'] = "-..",   ['E'] = ".",
+    ['F'] = "..-.",  ['G'] = "--.",   ['H'] = "....",  ['I'] = "..",    ['J'] = ".---",
+    ['K'] = "-.-",   ['L'] = ".-..",  ['M'] = "--",    ['N'] = "-.",    ['O'] = "---",
+    ['P'] = ".--.",  ['Q'] = "--.-",  ['R'] = ".-.",   ['S'] = "...",   ['T'] = "-",
+    ['U'] = "..-",   ['V'] = "...-",  ['W'] = ".--",   ['X'] = "-..-",  ['Y'] = "-.--",
+    ['Z'] = "--..",
+    ['0'] = "-----", ['1'] = ".----", ['2'] = "..---", ['3'] = "...--", ['4'] = "....-",
+    ['5'] = ".....", ['6'] = "-....", ['7'] = "--...", ['8'] = "---..", ['9'] = "----.",
+    ['/'] = "-..-.", ['?'] = "..--..", ['.'] = ".-.-.-", [','] = "--..--", ['='] = "-...-",
+};
+
+static uint32_t xorshift(uint32_t *state) {
+    *state ^= *state << 13;
+    *state ^= *state >> 17;
+    *state ^= *state << 5;
+
+    return *state;
+}
+
+/**
+ * Complex gaussian noise, unit variance per component
+ */
+static float complex gauss() {
+    float u1 = (xorshift(&rnd) + 1.0f) / 4294967296.0f;
+    float u2 = xorshift(&rnd) / 4294967296.0f;
+
+    return sqrtf(-2.0f * logf(u1)) * cexpf(I * 2.0f * M_PI * u2);
+}
+
+static void cw_keying(signal_t *s, const char *text) {
+    s->keying = malloc(strlen(text) * 26 + 7);
+    s->keying_len = 0;
+
+    for (const char *c = text; *c; c++) {
+        if (*c == ' ') {
+            /* Word gap is 7, 3 already added after char */
+            for (uint8_t i = 0; i < 4; i++) s->keying[s->keying_len++] = 0;
+            continue;
+        }
+
+        int         ch = toupper((unsigned char) *c);
+        const char  *code = ch < 128 ? morse[ch] : NULL;
+
+        if (!code) {
+            continue;
+        }
+
+        for (; *code; code++) {
+            uint8_t len = *code == '-' ? 3 : 1;
+
+            for (uint8_t i = 0; i < len; i++) s->keying[s->keying_len++] = 1;
+
+            s->keying[s->keying_len++] = 0;
+        }
+
+        for (uint8_t i = 0; i < 2; i++) s->keying[s->keying_len++] = 0;
+    }
+
+    for (uint8_t i = 0; i < 7; i++) s->keying[s->keying_len++] = 0;
+}
+
+static void ft8_tones(signal_t *s, const char *text) {
+    static const uint8_t costas[7] = { 3, 1, 4, 0, 6, 5, 2 };
+
+    uint32_t state = 2166136261u;
+
+    for (const char *c = text; *c; c++) {
+        state = (state ^ (uint8_t) *c) * 16777619u;
+    }
+
+    for (uint8_t i = 0; i < FT8_SYMBOLS; i++) {
+        s->tones[i] = xorshift(&state) % 8;
+    }
+
+    for (uint8_t i = 0; i < 7; i++) {
+        s->tones[i] = costas[i];
+        s->tones[36 + i] = costas[i];
+        s->tones[72 + i] = costas[i];
+    }
+}
+
+static void parse_line(const char *line) {
+    char        type[8];
+    uint32_t    freq;
+    float       db;
+    int         wpm;
+    int         n;
+
+    if (sscanf(line, "%7s", type) != 1 || type[0] == '#') {
+        return;
+    }
+
+    if (strcmp(type, "noise") == 0) {
+        if (sscanf(line, "%*s %f", &db) == 1) {
+            /* Split between I and Q */
+            noise_amp = powf(10.0f, db / 20.0f) / sqrtf(2.0f);
+        }
+        return;
+    }
+
+    if (signals_count >= MAX_SIGNALS) {
+        fprintf(stderr, "x6100 simulator: too many signals\n");
+        return;
+    }
+
+    signal_t *s = &signals[signals_count];
+
+    memset(s, 0, sizeof(*s));
+    s->phasor = 1.0f;
+
+    if (strcmp(type, "tone") == 0 && sscanf(line, "%*s %u %f", &freq, &db) == 2) {
+        s->type = SIGNAL_TONE;
+    } else if (strcmp(type, "cw") == 0 && sscanf(line, "%*s %u %f %i %n", &freq, &db, &wpm, &n) == 3 && wpm > 0) {
+        s->type = SIGNAL_CW;
+        s->dot_us = 1200000 / wpm;
+        cw_keying(s, line + n);
+    } else if (strcmp(type, "ft8") == 0 && sscanf(line, "%*s %u %f %n", &freq, &db, &n) == 2) {
+        s->type = SIGNAL_FT8;
+        ft8_tones(s, line + n);
+    } else {
+        fprintf(stderr, "x6100 simulator: wrong scene line \"%s\"\n", line);
+        return;
+    }
+
+    s->freq = freq;
+    s->amp = powf(10.0f, db / 20.0f);
+    signals_count++;
+}
+
+static void parse(const char *text) {
+    char line[256];
+
+    while (*text) {
+        size_t len = strcspn(text, "\n");
+
+        if (len >= sizeof(line)) {
+            len = sizeof(line) - 1;
+        }
+
+        memcpy(line, text, len);
+        line[len] = 0;
+        parse_line(line);
+
+        text += strcspn(text, "\n");
+
+        if (*text) {
+            text++;
+        }
+    }
+}
+
+void sim_scene_init() {
+    const char *path = getenv("X6100_SIM_SCENE");
+
+    for (size_t i = 0; i < signals_count; i++) {
+        free(signals[i].keying);
+    }
+    signals_count = 0;
+
+    if (path) {
+        FILE *f = fopen(path, "r");
+
+        if (f) {
+            char line[256];
+
+            while (fgets(line, sizeof(line), f)) {
+                line[strcspn(line, "\r\n")] = 0;
+                parse_line(line);
+            }
+            fclose(f);
+        } else {
+            fprintf(stderr, "x6100 simulator: can't open scene %s, using default\n", path);
+            path = NULL;
+        }
+    }
+
+    if (!path) {
+        parse(default_scene);
+    }
+
+    fprintf(stderr, "x6100 simulator: %zu signals in scene\n", signals_count);
+}
+
+/**
+ * Signal state at moment, returns amplitude and frequency offset
+ */
+static float signal_state(const signal_t *s, uint64_t time_us, float *offset) {
+    *offset = 0.0f;
+
+    switch (s->type) {
+        case SIGNAL_TONE:
+            return s->amp;
+
+        case SIGNAL_CW:
+            return s->keying[(time_us / s->dot_us) % s->keying_len] ? s->amp : 0.0f;
+
+        case SIGNAL_FT8: {
+            uint64_t t = time_us % FT8_SLOT_US;
+
+            if (t < FT8_START_US) {
+                return 0.0f;
+            }
+
+            uint64_t symbol = (t - FT8_START_US) / FT8_SYMBOL_US;
+
+            if (symbol >= FT8_SYMBOLS) {
+                return 0.0f;
+            }
+
+            *offset = s->tones[symbol] * FT8_SPACING;
+            return s->amp;
+        }
+    }
+
+    return 0.0f;
+}
+
+void sim_scene_render(float complex *samples, uint16_t count, uint32_t center, float gain, uint64_t time_us) {
+    float noise = noise_amp * gain;
+
+    for (uint16_t i = 0; i < count; i++) {
+        samples[i] = noise * gauss();
+    }
+
+    for (size_t n = 0; n < signals_count; n++) {
+        signal_t    *s = &signals[n];
+        float       offset;
+        float       env = signal_state(s, time_us, &offset) * gain;
+        float       df = (float) s->freq - (float) center + offset;
+
+        if (fabsf(df) >= HALF_SPAN || (env == 0.0f && s->env == 0.0f)) {
+            s->env = env;
+            continue;
+        }
+
+        /* Frequency is constant within packet, amplitude is ramped to avoid clicks */
+
+        float complex   step = cexpf(I * 2.0f * M_PI * df / SIM_SAMPLE_RATE);
+        float           env_step = (env - s->env) / count;
+        float complex   p = s->phasor;
+        float           a = s->env;
+
+        for (uint16_t i = 0; i < count; i++) {
+            samples[i] += a * p;
+            p *= step;
+            a += env_step;
+        }
+
+        s->phasor = p / cabsf(p);
+        s->env = env;
+    }
+}
@@ -0,0 +1,69 @@
+/*
+ *  SPDX-License-Identifier: LGPL-2.1-or-later
+ *
+ *  Xiegu X6100 LVGL GUI
+ *
+ *  Copyright (c) 2024 Georgy Dyuldin aka R2RFE
+ */
+
+#pragma once
+
+#include <aether_radio/x6100_control/control.h>
+
+#include <complex.h>
+#include <pthread.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+/**
+ * Simulated x6100_control backend, shared state of control, gpio and flow.
+ *
+ * Control functions are called by GUI under radio lock, flow is read by
+ * radio thread, so state is guarded by sim.mux.
+ */
+
+#define SIM_SAMPLE_RATE     100000
+
+typedef struct {
+    pthread_mutex_t mux;
+
+    uint32_t        freq[2];
+    x6100_mode_t    mode[2];
+    uint8_t         att[2];
+    uint8_t         pre[2];
+    x6100_vfo_t     vfo;
+    int32_t         filter_low;
+    int32_t         filter_high;
+    uint16_t        key_tone;
+
+    float           txpwr;
+    bool            ptt;
+    bool            modem;
+    bool            key;
+    bool            swrscan;
+    bool            charger;
+
+    bool            atu_on;
+    bool            atu_tune;
+    uint32_t        atu_network;
+    uint64_t        atu_start;
+} sim_state_t;
+
+extern sim_state_t  sim;
+
+uint64_t sim_time_us();
+
+/**
+ * ATU network value, which matches antenna at freq
+ */
+uint32_t sim_atu_network(uint32_t freq);
+
+/* Scene */
+
+void sim_scene_init();
+
+/**
+ * Add scene signals around center freq to samples. time_us - wall clock
+ * time of first sample, used for FT8 slots and CW keying
+ */
+void sim_scene_render(float complex *samples, uint16_t count, uint32_t center, float gain, uint64_t time_us);
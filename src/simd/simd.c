@@ -0,0 +1,276 @@
+/*
+ *  SPDX-License-Identifier: LGPL-2.1-or-later
+ *
+ *  Xiegu X6100 LVGL GUI
+ *
+ *  Copyright (c) 2024 Georgy Dyuldin aka R2RFE
+ */
+
+#include "simd.h"
+
+#include <math.h>
+
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+#define SIMD_NEON 1
+#include <arm_neon.h>
+#else
+#define SIMD_NEON 0
+#endif
+
+#define S16_LIMIT   32767.0f
+#define ROTATE_TILE 16
+
+const char * simd_backend() {
+    return SIMD_NEON ? "neon" : "scalar";
+}
+
+void simd_add_scalar_f32(const float *x, size_t n, float k, float *y) {
+    size_t i = 0;
+
+#if SIMD_NEON
+    float32x4_t vk = vdupq_n_f32(k);
+
+    for (; i + 4 <= n; i += 4) {
+        vst1q_f32(y + i, vaddq_f32(vld1q_f32(x + i), vk));
+    }
+#endif
+    for (; i < n; i++) {
+        y[i] = x[i] + k;
+    }
+}
+
+void simd_s16_to_f32(const int16_t *x, size_t n, float scale, float *y) {
+    size_t i = 0;
+
+#if SIMD_NEON
+    for (; i + 8 <= n; i += 8) {
+        int16x8_t   v = vld1q_s16(x + i);
+
+        vst1q_f32(y + i, vmulq_n_f32(vcvtq_f32_s32(vmovl_s16(vget_low_s16(v))), scale));
+        vst1q_f32(y + i + 4, vmulq_n_f32(vcvtq_f32_s32(vmovl_s16(vget_high_s16(v))), scale));
+    }
+#endif
+    for (; i < n; i++) {
+        y[i] = x[i] * scale;
+    }
+}
+
+#if SIMD_NEON
+static inline int16x4_t gain_s16x4(int16x4_t x, float32x4_t scale) {
+    float32x4_t v = vmulq_f32(vcvtq_f32_s32(vmovl_s16(x)), scale);
+
+    v = vminq_f32(vmaxq_f32(v, vdupq_n_f32(-S16_LIMIT)), vdupq_n_f32(S16_LIMIT));
+
+    return vmovn_s32(vcvtq_s32_f32(v));
+}
+#endif
+
+static inline int16_t gain_s16(int16_t x, float scale) {
+    float v = x * scale;
+
+    if (v > S16_LIMIT) {
+        v = S16_LIMIT;
+    } else if (v < -S16_LIMIT) {
+        v = -S16_LIMIT;
+    }
+    return (int16_t) v;
+}
+
+void simd_gain_s16(const int16_t *x, size_t n, float scale, int16_t *y) {
+    size_t i = 0;
+
+#if SIMD_NEON
+    float32x4_t vs = vdupq_n_f32(scale);
+
+    for (; i + 8 <= n; i += 8) {
+        int16x8_t   v = vld1q_s16(x + i);
+
+        vst1q_s16(y + i, vcombine_s16(gain_s16x4(vget_low_s16(v), vs), gain_s16x4(vget_high_s16(v), vs)));
+    }
+#endif
+    for (; i < n; i++) {
+        y[i] = gain_s16(x[i], scale);
+    }
+}
+
+void simd_gain_ramp_s16(const int16_t *x, size_t n, float scale1, float scale2, int16_t *y) {
+    if (n == 0) {
+        return;
+    }
+
+    float   step = (scale2 - scale1) / n;
+    size_t  i = 0;
+
+#if SIMD_NEON
+    static const float  idx[4] = {0.0f, 1.0f, 2.0f, 3.0f};
+    float32x4_t         vi = vld1q_f32(idx);
+    float32x4_t         vs1 = vdupq_n_f32(scale1);
+
+    for (; i + 8 <= n; i += 8) {
+        int16x8_t   v = vld1q_s16(x + i);
+        float32x4_t lo = vmlaq_n_f32(vs1, vaddq_f32(vi, vdupq_n_f32(i)), step);
+        float32x4_t hi = vmlaq_n_f32(vs1, vaddq_f32(vi, vdupq_n_f32(i + 4)), step);
+
+        vst1q_s16(y + i, vcombine_s16(gain_s16x4(vget_low_s16(v), lo), gain_s16x4(vget_high_s16(v), hi)));
+    }
+#endif
+    for (; i < n; i++) {
+        y[i] = gain_s16(x[i], scale1 + i * step);
+    }
+}
+
+void simd_normalize_u8(const float *x, size_t n, float min, float max, uint8_t *y, bool reverse) {
+    float   k = 255.0f / (max - min);
+    size_t  i = 0;
+
+#if SIMD_NEON
+    float32x4_t vmin = vdupq_n_f32(min);
+    float32x4_t vzero = vdupq_n_f32(0.0f);
+    float32x4_t vtop = vdupq_n_f32(255.0f);
+    uint16x4_t  h[4];
+
+    for (; i + 16 <= n; i += 16) {
+        for (int j = 0; j < 4; j++) {
+            float32x4_t v = vmulq_n_f32(vsubq_f32(vld1q_f32(x + i + j * 4), vmin), k);
+
+            v = vminq_f32(vmaxq_f32(v, vzero), vtop);
+            h[j] = vmovn_u32(vcvtq_u32_f32(v));
+        }
+
+        uint8x16_t  b = vcombine_u8(vmovn_u16(vcombine_u16(h[0], h[1])), vmovn_u16(vcombine_u16(h[2], h[3])));
+
+        if (reverse) {
+            b = vrev64q_u8(b);
+            vst1q_u8(y + n - i - 16, vcombine_u8(vget_high_u8(b), vget_low_u8(b)));
+        } else {
+            vst1q_u8(y + i, b);
+        }
+    }
+#endif
+    for (; i < n; i++) {
+        float v = (x[i] - min) * k;
+
+        if (v < 0.0f) {
+            v = 0.0f;
+        } else if (v > 255.0f) {
+            v = 255.0f;
+        }
+        y[reverse ? n - 1 - i : i] = (uint8_t) v;
+    }
+}
+
+#if SIMD_NEON
+/* log2(1 + t), t in [0, 1), max error 1.7e-5 */
+static inline float32x4_t log2_neon(float32x4_t x) {
+    int32x4_t   bits = vreinterpretq_s32_f32(x);
+    float32x4_t e = vcvtq_f32_s32(vsubq_s32(vshrq_n_s32(bits, 23), vdupq_n_s32(127)));
+    int32x4_t   m_bits = vorrq_s32(vandq_s32(bits, vdupq_n_s32(0x007FFFFF)), vdupq_n_s32(0x3F800000));
+    float32x4_t t = vsubq_f32(vreinterpretq_f32_s32(m_bits), vdupq_n_f32(1.0f));
+    float32x4_t p = vdupq_n_f32(0.045268292f);
+
+    p = vmlaq_f32(vdupq_n_f32(-0.193516522f), p, t);
+    p = vmlaq_f32(vdupq_n_f32(0.415245559f), p, t);
+    p = vmlaq_f32(vdupq_n_f32(-0.708865217f), p, t);
+    p = vmlaq_f32(vdupq_n_f32(1.441879896f), p, t);
+
+    return vmlaq_f32(e, p, t);
+}
+
+static inline uint16x4_t power_db_neon(float32x4_t re, float32x4_t im, float k, float32x4_t offset) {
+    float32x4_t mag2 = vmlaq_f32(vmulq_f32(re, re), im, im);
+    float32x4_t v = vmlaq_n_f32(offset, log2_neon(mag2), k);
+
+    v = vminq_f32(vmaxq_f32(v, vdupq_n_f32(0.0f)), vdupq_n_f32(255.0f));
+
+    return vmovn_u32(vcvtq_u32_f32(v));
+}
+#endif
+
+void simd_power_db_u8(const float *iq, size_t n, size_t stride, float scale, float offset, uint8_t *y) {
+    size_t i = 0;
+
+#if SIMD_NEON
+    /* 10 * log10(x) = 10 * log10(2) * log2(x) */
+    float       k = 3.010299957f * scale;
+    float32x4_t voffset = vdupq_n_f32(offset);
+
+    if (stride == 1) {
+        for (; i + 8 <= n; i += 8) {
+            float32x4x2_t   a = vld2q_f32(iq + i * 2);
+            float32x4x2_t   b = vld2q_f32(iq + i * 2 + 8);
+            uint16x4_t      lo = power_db_neon(a.val[0], a.val[1], k, voffset);
+            uint16x4_t      hi = power_db_neon(b.val[0], b.val[1], k, voffset);
+
+            vst1_u8(y + i, vmovn_u16(vcombine_u16(lo, hi)));
+        }
+    } else if (stride == 2) {
+        for (; i + 8 <= n; i += 8) {
+            float32x4x4_t   a = vld4q_f32(iq + i * 4);
+            float32x4x4_t   b = vld4q_f32(iq + i * 4 + 16);
+            uint16x4_t      lo = power_db_neon(a.val[0], a.val[1], k, voffset);
+            uint16x4_t      hi = power_db_neon(b.val[0], b.val[1], k, voffset);
+
+            vst1_u8(y + i, vmovn_u16(vcombine_u16(lo, hi)));
+        }
+    }
+#endif
+    for (; i < n; i++) {
+        const float *c = iq + i * stride * 2;
+        float       db = 10.0f * log10f(c[0] * c[0] + c[1] * c[1]);
+        float       v = db * scale + offset;
+
+        if (v < 0.0f) {
+            v = 0.0f;
+        } else if (v > 255.0f) {
+            v = 255.0f;
+        }
+        y[i] = (uint8_t) v;
+    }
+}
+
+static void rotate_tile(const uint32_t *x, size_t xs, size_t w, size_t h, uint32_t *y, size_t ys) {
+    size_t r = 0;
+
+#if SIMD_NEON
+    for (; r + 4 <= h; r += 4) {
+        size_t c = 0;
+
+        for (; c + 4 <= w; c += 4) {
+            const uint32_t  *s = x + r * xs + c;
+            uint32_t        *d = y + (w - 1 - c) * ys + r;
+
+            /* 4x4 transpose, source columns become destination rows */
+            uint32x4x2_t    t01 = vtrnq_u32(vld1q_u32(s), vld1q_u32(s + xs));
+            uint32x4x2_t    t23 = vtrnq_u32(vld1q_u32(s + xs * 2), vld1q_u32(s + xs * 3));
+
+            vst1q_u32(d, vcombine_u32(vget_low_u32(t01.val[0]), vget_low_u32(t23.val[0])));
+            vst1q_u32(d - ys, vcombine_u32(vget_low_u32(t01.val[1]), vget_low_u32(t23.val[1])));
+            vst1q_u32(d - ys * 2, vcombine_u32(vget_high_u32(t01.val[0]), vget_high_u32(t23.val[0])));
+            vst1q_u32(d - ys * 3, vcombine_u32(vget_high_u32(t01.val[1]), vget_high_u32(t23.val[1])));
+        }
+
+        for (; c < w; c++) {
+            for (size_t k = 0; k < 4; k++) {
+                y[(w - 1 - c) * ys + r + k] = x[(r + k) * xs + c];
+            }
+        }
+    }
+#endif
+    for (; r < h; r++) {
+        for (size_t c = 0; c < w; c++) {
+            y[(w - 1 - c) * ys + r] = x[r * xs + c];
+        }
+    }
+}
+
+void simd_rotate90_u32(const uint32_t *x, size_t x_stride, size_t w, size_t h, uint32_t *y, size_t y_stride) {
+    for (size_t ty = 0; ty < h; ty += ROTATE_TILE) {
+        size_t th = h - ty < ROTATE_TILE ? h - ty : ROTATE_TILE;
+
+        for (size_t tx = 0; tx < w; tx += ROTATE_TILE) {
+            size_t tw = w - tx < ROTATE_TILE ? w - tx : ROTATE_TILE;
+
+            rotate_tile(x + ty * x_stride + tx, x_stride, tw, th, y + (w - tx - tw) * y_stride + ty, y_stride);
+        }
+    }
+}
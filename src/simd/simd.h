@@ -0,0 +1,69 @@
+/*
+ *  SPDX-License-Identifier: LGPL-2.1-or-later
+ *
+ *  Xiegu X6100 LVGL GUI
+ *
+ *  Copyright (c) 2024 Georgy Dyuldin aka R2RFE
+ */
+
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * Vector kernels for per-sample hot loops.
+ *
+ * NEON implementation is selected at build time (__ARM_NEON), otherwise
+ * portable scalar code is used. All kernels process any n, the tail is
+ * handled by scalar code. Results of NEON and scalar versions may differ
+ * by one LSB for integer outputs.
+ */
+
+/**
+ * Name of the selected backend ("neon" or "scalar")
+ */
+const char * simd_backend();
+
+/**
+ * y[i] = x[i] + k. In-place is allowed
+ */
+void simd_add_scalar_f32(const float *x, size_t n, float k, float *y);
+
+/**
+ * y[i] = x[i] * scale for int16 input. Use scale 1/32768 for [-1, 1) range
+ */
+void simd_s16_to_f32(const int16_t *x, size_t n, float scale, float *y);
+
+/**
+ * y[i] = clamp(x[i] * scale, -32767, 32767). In-place is allowed
+ */
+void simd_gain_s16(const int16_t *x, size_t n, float scale, int16_t *y);
+
+/**
+ * Same as simd_gain_s16, scale changes linearly from scale1 (first sample)
+ * towards scale2 (reached after the last one)
+ */
+void simd_gain_ramp_s16(const int16_t *x, size_t n, float scale1, float scale2, int16_t *y);
+
+/**
+ * Map [min, max] to [0, 255] with clamp: y[i] = (x[i] - min) * 255 / (max - min).
+ * With reverse set, output is written in backward order: y[n - 1 - i]
+ */
+void simd_normalize_u8(const float *x, size_t n, float min, float max, uint8_t *y, bool reverse);
+
+/**
+ * y[i] = clamp(10 * log10(|x[i * stride]|^2) * scale + offset, 0, 255).
+ *
+ * iq is array of interleaved complex values (re, im), stride is in complex
+ * items. NEON version uses polynomial log2 with error less than 1e-4 dB.
+ */
+void simd_power_db_u8(const float *iq, size_t n, size_t stride, float scale, float offset, uint8_t *y);
+
+/**
+ * Rotate w x h block of 32 bit pixels by 90 degrees counter-clockwise (LV_DISP_ROT_90):
+ * y[(w - 1 - c) * y_stride + r] = x[r * x_stride + c]. Strides are in pixels,
+ * blocks should not overlap. Processed by cache sized tiles
+ */
+void simd_rotate90_u32(const uint32_t *x, size_t x_stride, size_t w, size_t h, uint32_t *y, size_t y_stride);
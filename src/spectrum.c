@@ -18,6 +18,7 @@
 #include "rtty.h"
 #include "recorder.h"
 #include "pubsub_ids.h"
+#include "dsp/specdraw.h"
 
 #include <stdlib.h>
 #include <pthread.h>
@@ -27,6 +28,9 @@
 #define VISOR_HEIGHT_TX (100 - 61)
 #define VISOR_HEIGHT_RX 100
 
+/* Traces are drawn directly into 32 bit draw buffer */
+_Static_assert(sizeof(lv_color_t) == sizeof(uint32_t), "LV_COLOR_DEPTH 32 is expected");
+
 static float            grid_min = DEFAULT_MIN;
 static float            grid_max = DEFAULT_MAX;
 
@@ -43,22 +47,31 @@ static int16_t          delta_surplus = 0;
 
 static bool             spectrum_tx = false;
 
-typedef struct {
-    float       val;
-    uint64_t    time;
-} peak_t;
-
-static peak_t           *spectrum_peak;
+/* Traces are computed by DSP, only copies for drawing */
+static float            *spectrum_peak;
+static float            *spectrum_min;
+static bool             peak_on = false;
+static bool             min_on = false;
 
 static pthread_mutex_t  data_mux;
 
 static void zoom_changed_cd(void * s, lv_msg_t * m);
 
+static void canvas_init(specdraw_canvas_t *canvas, lv_draw_ctx_t *draw_ctx) {
+    canvas->buf = draw_ctx->buf;
+    canvas->stride = lv_area_get_width(draw_ctx->buf_area);
+    canvas->buf_x = draw_ctx->buf_area->x1;
+    canvas->buf_y = draw_ctx->buf_area->y1;
+    canvas->clip_x1 = draw_ctx->clip_area->x1;
+    canvas->clip_y1 = draw_ctx->clip_area->y1;
+    canvas->clip_x2 = draw_ctx->clip_area->x2;
+    canvas->clip_y2 = draw_ctx->clip_area->y2;
+}
+
 static void spectrum_draw_cb(lv_event_t * e) {
     lv_obj_t            *obj = lv_event_get_target(e);
     lv_draw_ctx_t       *draw_ctx = lv_event_get_draw_ctx(e);
     lv_draw_line_dsc_t  main_line_dsc;
-    lv_draw_line_dsc_t  peak_line_dsc;
     lv_draw_line_dsc_t  main_center_line_dsc;
 
     if (!spectrum_buf) {
@@ -73,18 +86,11 @@ static void spectrum_draw_cb(lv_event_t * e) {
         max = grid_max;
     }
 
-    /* Lines */
-
     lv_draw_line_dsc_init(&main_line_dsc);
 
     main_line_dsc.color = lv_color_hex(0xAAAAAA);
     main_line_dsc.width = 1;
 
-    lv_draw_line_dsc_init(&peak_line_dsc);
-
-    peak_line_dsc.color = lv_color_hex(0x555555);
-    peak_line_dsc.width = 1;
-
     lv_coord_t x1 = obj->coords.x1;
     lv_coord_t y1 = obj->coords.y1;
 
@@ -94,50 +100,28 @@ static void spectrum_draw_cb(lv_event_t * e) {
     x1 += params_lo_offset_get() * zoom_factor * w / width_hz;
 
     lv_point_t main_a, main_b;
-    lv_point_t peak_a, peak_b;
 
-    if (!params.spectrum_filled) {
-        main_b.x = x1;
-        main_b.y = y1 + h;
-    }
+    /* Traces */
 
-    peak_b.x = x1;
-    peak_b.y = y1 + h;
+    specdraw_canvas_t   canvas;
+    specdraw_area_t     trace_area = { .x = x1, .y = y1, .w = w, .h = h, .min = min, .max = max };
 
-    for (uint16_t i = 0; i < spectrum_size; i++) {
-        float       v = (spectrum_buf[i] - min) / (max - min);
-        uint16_t    x = i * w / spectrum_size;
+    canvas_init(&canvas, draw_ctx);
 
-        /* Peak */
-
-        if (params.spectrum_peak && !spectrum_tx) {
-            float v_peak = (spectrum_peak[i].val - min) / (max - min);
-
-            peak_a.x = x1 + x;
-            peak_a.y = y1 + (1.0f - v_peak) * h;
-
-            lv_draw_line(draw_ctx, &peak_line_dsc, &peak_a, &peak_b);
-
-            peak_b = peak_a;
-        }
-
-        /* Main */
-
-        main_a.x = x1 + x;
-        main_a.y = y1 + (1.0f - v) * h;
-
-        if (params.spectrum_filled) {
-            main_b.x = main_a.x;
-            main_b.y = y1 + h;
-        }
-
-        lv_draw_line(draw_ctx, &main_line_dsc, &main_a, &main_b);
+    if (peak_on && !spectrum_tx) {
+        specdraw_trace(&canvas, &trace_area, spectrum_peak, spectrum_size, SPECDRAW_LINE,
+                       lv_color_to32(lv_color_hex(0x555555)), LV_OPA_COVER);
+    }
 
-        if (!params.spectrum_filled) {
-            main_b = main_a;
-        }
+    if (min_on && !spectrum_tx) {
+        specdraw_trace(&canvas, &trace_area, spectrum_min, spectrum_size, SPECDRAW_LINE,
+                       lv_color_to32(lv_color_hex(0x3A4A5A)), LV_OPA_COVER);
     }
 
+    specdraw_trace(&canvas, &trace_area, spectrum_buf, spectrum_size,
+                   params.spectrum_filled ? SPECDRAW_FILLED : SPECDRAW_LINE,
+                   lv_color_to32(main_line_dsc.color), LV_OPA_COVER);
+
     /* Filter */
 
     lv_draw_rect_dsc_t  rect_dsc;
@@ -244,7 +228,8 @@ static void rx_cb(lv_event_t * e) {
 lv_obj_t * spectrum_init(lv_obj_t * parent) {
     pthread_mutex_init(&data_mux, NULL);
     spectrum_buf = malloc(spectrum_size * sizeof(float));
-    spectrum_peak = malloc(spectrum_size * sizeof(peak_t));
+    spectrum_peak = malloc(spectrum_size * sizeof(float));
+    spectrum_min = malloc(spectrum_size * sizeof(float));
     spectrum_min_max_reset();
 
     obj = lv_obj_create(parent);
@@ -259,29 +244,29 @@ lv_obj_t * spectrum_init(lv_obj_t * parent) {
     return obj;
 }
 
-void spectrum_data(float *data_buf, uint16_t size, bool tx) {
-    uint64_t now = get_time();
-
+void spectrum_data(const float *data_buf, const float *peak_buf, const float *min_buf, uint16_t size, bool tx) {
     pthread_mutex_lock(&data_mux);
     spectrum_tx = tx;
+
     for (uint16_t i = 0; i < size; i++) {
         spectrum_buf[i] = data_buf[size - i - 1];
+    }
+
+    if (peak_buf) {
+        for (uint16_t i = 0; i < size; i++) {
+            spectrum_peak[i] = peak_buf[size - i - 1];
+        }
+    }
 
-        if (params.spectrum_peak && !tx) {
-            float   v = spectrum_buf[i];
-            peak_t  *peak = &spectrum_peak[i];
-
-            if (v > peak->val) {
-                peak->time = now;
-                peak->val = v;
-            } else {
-                if (now - peak->time > params.spectrum_peak_hold) {
-                    peak->val -= params.spectrum_peak_speed;
-                }
-            }
+    if (min_buf) {
+        for (uint16_t i = 0; i < size; i++) {
+            spectrum_min[i] = min_buf[size - i - 1];
         }
     }
 
+    peak_on = peak_buf != NULL;
+    min_on = min_buf != NULL;
+
     pthread_mutex_unlock(&data_mux);
     event_send(obj, LV_EVENT_REFRESH, NULL);
 }
@@ -334,19 +319,16 @@ void spectrum_update_min(float db) {
 
 void spectrum_clear() {
     spectrum_min_max_reset();
-    uint64_t now = get_time();
 
     for (uint16_t i = 0; i < spectrum_size; i++) {
         spectrum_buf[i] = S_MIN;
-        spectrum_peak[i].val = S_MIN;
-        spectrum_peak[i].time = now;
+        spectrum_peak[i] = S_MIN;
+        spectrum_min[i] = S_MIN;
     }
+    dsp_spectrum_clear();
 }
 
 void spectrum_change_freq(int16_t df) {
-    peak_t      *from, *to;
-    uint64_t    time = get_time();
-
     uint16_t    div = width_hz / spectrum_size / zoom_factor;
     int16_t     surplus = df % div;
     int32_t     delta = df / div;
@@ -366,38 +348,14 @@ void spectrum_change_freq(int16_t df) {
         return;
     }
 
-    if (delta > 0) {
-        for (int16_t i = 0; i < spectrum_size - 1; i++) {
-            to = &spectrum_peak[i];
-
-            if (i >= spectrum_size - delta) {
-                to->val = S_MIN;
-                to->time = time;
-            } else {
-                from = &spectrum_peak[i + delta];
-                *to = *from;
-            }
-        }
-    } else {
-        delta = -delta;
-
-        for (int16_t i = spectrum_size - 1; i > 0; i--) {
-            to = &spectrum_peak[i];
-
-            if (i <= delta) {
-                to->val = S_MIN;
-                to->time = time;
-            } else {
-                from = &spectrum_peak[i - delta];
-                *to = *from;
-            }
-        }
-    }
+    /* Displayed buffer is reversed, so sign is the same in DSP order */
+    dsp_spectrum_shift(delta);
 }
 
 
 static void zoom_changed_cd(void * s, lv_msg_t * m) {
     zoom_factor = *(uint16_t *) lv_msg_get_payload(m);
+
+    /* DSP restarts traces on level change */
     dsp_set_spectrum_factor(zoom_factor);
-    spectrum_clear();
 }
@@ -14,7 +14,10 @@
 #include "lvgl/lvgl.h"
 
 lv_obj_t * spectrum_init(lv_obj_t * parent);
-void spectrum_data(float *data_buf, uint16_t size, bool tx);
+/**
+ * Traces from DSP, peak_buf and min_buf are NULL if disabled
+ */
+void spectrum_data(const float *data_buf, const float *peak_buf, const float *min_buf, uint16_t size, bool tx);
 void spectrum_min_max_reset();
 
 float spectrum_get_min();
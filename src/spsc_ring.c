@@ -0,0 +1,100 @@
+/*
+ *  SPDX-License-Identifier: LGPL-2.1-or-later
+ *
+ *  Xiegu X6100 LVGL GUI
+ *
+ *  Copyright (c) 2024 Georgy Dyuldin aka R2RFE
+ */
+
+#include "spsc_ring.h"
+
+#include <stdlib.h>
+#include <stdatomic.h>
+
+struct spsc_ring_s {
+    uint8_t             *data;
+    size_t              item_size;
+    size_t              mask;
+
+    _Atomic size_t      head;       /* written by producer */
+    _Atomic size_t      tail;       /* written by consumer */
+    _Atomic uint32_t    overruns;
+};
+
+spsc_ring_t spsc_ring_create(size_t item_size, size_t count) {
+    size_t n = 1;
+
+    /* Round up to power of 2 */
+    while (n < count) {
+        n <<= 1;
+    }
+
+    spsc_ring_t ring = (spsc_ring_t) malloc(sizeof(struct spsc_ring_s));
+
+    ring->data = malloc(item_size * n);
+    ring->item_size = item_size;
+    ring->mask = n - 1;
+
+    atomic_init(&ring->head, 0);
+    atomic_init(&ring->tail, 0);
+    atomic_init(&ring->overruns, 0);
+
+    return ring;
+}
+
+void spsc_ring_destroy(spsc_ring_t ring) {
+    free(ring->data);
+    free(ring);
+}
+
+void * spsc_ring_write_begin(spsc_ring_t ring) {
+    size_t head = atomic_load_explicit(&ring->head, memory_order_relaxed);
+    size_t tail = atomic_load_explicit(&ring->tail, memory_order_acquire);
+
+    if (head - tail > ring->mask) {
+        atomic_fetch_add_explicit(&ring->overruns, 1, memory_order_relaxed);
+        return NULL;
+    }
+
+    return ring->data + (head & ring->mask) * ring->item_size;
+}
+
+void spsc_ring_write_commit(spsc_ring_t ring) {
+    size_t head = atomic_load_explicit(&ring->head, memory_order_relaxed);
+
+    atomic_store_explicit(&ring->head, head + 1, memory_order_release);
+}
+
+void * spsc_ring_read_begin(spsc_ring_t ring) {
+    size_t tail = atomic_load_explicit(&ring->tail, memory_order_relaxed);
+    size_t head = atomic_load_explicit(&ring->head, memory_order_acquire);
+
+    if (head == tail) {
+        return NULL;
+    }
+
+    return ring->data + (tail & ring->mask) * ring->item_size;
+}
+
+void spsc_ring_read_commit(spsc_ring_t ring) {
+    size_t tail = atomic_load_explicit(&ring->tail, memory_order_relaxed);
+
+    atomic_store_explicit(&ring->tail, tail + 1, memory_order_release);
+}
+
+void spsc_ring_flush(spsc_ring_t ring) {
+    size_t head = atomic_load_explicit(&ring->head, memory_order_acquire);
+
+    atomic_store_explicit(&ring->tail, head, memory_order_release);
+}
+
+size_t spsc_ring_size(spsc_ring_t ring) {
+    size_t tail = atomic_load_explicit(&ring->tail, memory_order_acquire);
+    size_t head = atomic_load_explicit(&ring->head, memory_order_acquire);
+
+    return head - tail;
+}
+
+uint32_t spsc_ring_overruns(spsc_ring_t ring) {
+    return atomic_load_explicit(&ring->overruns, memory_order_relaxed);
+}
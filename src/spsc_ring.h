@@ -0,0 +1,43 @@
+/*
+ *  SPDX-License-Identifier: LGPL-2.1-or-later
+ *
+ *  Xiegu X6100 LVGL GUI
+ *
+ *  Copyright (c) 2024 Georgy Dyuldin aka R2RFE
+ */
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+/**
+ * Lock-free single producer / single consumer ring of fixed size blocks.
+ * All memory is allocated at creation time, producer never blocks:
+ * if there is no free block, write is dropped and counted as overrun.
+ */
+typedef struct spsc_ring_s * spsc_ring_t;
+
+spsc_ring_t spsc_ring_create(size_t item_size, size_t count);
+void spsc_ring_destroy(spsc_ring_t ring);
+
+/**
+ * Producer side. Return pointer to free block or NULL on overrun
+ */
+void * spsc_ring_write_begin(spsc_ring_t ring);
+void spsc_ring_write_commit(spsc_ring_t ring);
+
+/**
+ * Consumer side. Return pointer to oldest block or NULL if ring is empty
+ */
+void * spsc_ring_read_begin(spsc_ring_t ring);
+void spsc_ring_read_commit(spsc_ring_t ring);
+
+/**
+ * Consumer side. Drop all queued blocks
+ */
+void spsc_ring_flush(spsc_ring_t ring);
+
+size_t spsc_ring_size(spsc_ring_t ring);
+uint32_t spsc_ring_overruns(spsc_ring_t ring);
@@ -0,0 +1,167 @@
+/*
+ *  SPDX-License-Identifier: LGPL-2.1-or-later
+ *
+ *  Xiegu X6100 LVGL GUI
+ *
+ *  Copyright (c) 2024 Georgy Dyuldin aka R2RFE
+ */
+
+#include "static_layer.h"
+
+#include <stdbool.h>
+#include <stdlib.h>
+#include <time.h>
+
+struct static_layer_s {
+    const char              *name;
+    static_layer_draw_cb_t  cb;
+    lv_img_dsc_t            *img;
+    bool                    valid;
+    static_layer_stats_t    stats;
+
+    struct static_layer_s   *next;
+};
+
+static struct static_layer_s    *layers = NULL;
+
+static uint64_t now_us() {
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+
+    return (uint64_t) now.tv_sec * 1000000L + now.tv_nsec / 1000L;
+}
+
+static_layer_t static_layer_create(const char *name, static_layer_draw_cb_t cb) {
+    static_layer_t layer = (static_layer_t) calloc(1, sizeof(struct static_layer_s));
+
+    layer->name = name;
+    layer->cb = cb;
+    layer->next = layers;
+    layers = layer;
+
+    return layer;
+}
+
+void static_layer_destroy(static_layer_t layer) {
+    for (struct static_layer_s **p = &layers; *p; p = &(*p)->next) {
+        if (*p == layer) {
+            *p = layer->next;
+            break;
+        }
+    }
+
+    if (layer->img) {
+        lv_img_buf_free(layer->img);
+    }
+
+    free(layer);
+}
+
+void static_layer_invalidate(static_layer_t layer) {
+    layer->valid = false;
+}
+
+void static_layer_invalidate_all() {
+    for (struct static_layer_s *layer = layers; layer; layer = layer->next) {
+        layer->valid = false;
+    }
+}
+
+/**
+ * Like lv_canvas drawing: fake display with the layer image as a buffer
+ */
+static void render(static_layer_t layer, lv_coord_t w, lv_coord_t h) {
+    uint64_t start = now_us();
+
+    if (!layer->img || layer->img->header.w != w || layer->img->header.h != h) {
+        if (layer->img) {
+            lv_img_buf_free(layer->img);
+        }
+
+        layer->img = lv_img_buf_alloc(w, h, LV_IMG_CF_TRUE_COLOR_ALPHA);
+
+        if (!layer->img) {
+            return;
+        }
+    }
+
+    lv_memset_00((void *) layer->img->data, layer->img->data_size);
+
+    lv_area_t       area = { .x1 = 0, .y1 = 0, .x2 = w - 1, .y2 = h - 1 };
+    lv_disp_t       disp;
+    lv_disp_drv_t   drv;
+
+    lv_memset_00(&disp, sizeof(disp));
+    lv_disp_drv_init(&drv);
+
+    drv.hor_res = w;
+    drv.ver_res = h;
+    disp.driver = &drv;
+
+    lv_draw_ctx_t *draw_ctx = lv_mem_alloc(sizeof(lv_draw_sw_ctx_t));
+
+    lv_draw_sw_init_ctx(&drv, draw_ctx);
+    drv.draw_ctx = draw_ctx;
+
+    draw_ctx->clip_area = &area;
+    draw_ctx->buf_area = &area;
+    draw_ctx->buf = (void *) layer->img->data;
+
+    lv_disp_drv_use_generic_set_px_cb(&drv, LV_IMG_CF_TRUE_COLOR_ALPHA);
+
+    lv_disp_t *refr = _lv_refr_get_disp_refreshing();
+
+    _lv_refr_set_disp_refreshing(&disp);
+    layer->cb(draw_ctx, &area);
+    _lv_refr_set_disp_refreshing(refr);
+
+    lv_draw_sw_deinit_ctx(&drv, draw_ctx);
+    lv_mem_free(draw_ctx);
+
+    uint64_t us = now_us() - start;
+
+    layer->valid = true;
+    layer->stats.renders++;
+    layer->stats.render_us += us;
+
+    LV_LOG_TRACE("%s: static part %llu us", layer->name, (unsigned long long) us);
+}
+
+void static_layer_draw(static_layer_t layer, lv_draw_ctx_t *draw_ctx, const lv_area_t *coords) {
+    lv_coord_t w = lv_area_get_width(coords);
+    lv_coord_t h = lv_area_get_height(coords);
+
+    if (!layer->valid || !layer->img || layer->img->header.w != w || layer->img->header.h != h) {
+        render(layer, w, h);
+
+        if (!layer->valid) {
+            return;
+        }
+    }
+
+    uint64_t            start = now_us();
+    lv_draw_img_dsc_t   dsc;
+
+    lv_draw_img_dsc_init(&dsc);
+    lv_draw_img_decoded(draw_ctx, &dsc, coords, layer->img->data, LV_IMG_CF_TRUE_COLOR_ALPHA);
+
+    layer->stats.draws++;
+    layer->stats.draw_us += now_us() - start;
+}
+
+void static_layer_get_stats(static_layer_t layer, static_layer_stats_t *stats) {
+    if (layer) {
+        *stats = layer->stats;
+        return;
+    }
+
+    lv_memset_00(stats, sizeof(*stats));
+
+    for (layer = layers; layer; layer = layer->next) {
+        stats->renders += layer->stats.renders;
+        stats->render_us += layer->stats.render_us;
+        stats->draws += layer->stats.draws;
+        stats->draw_us += layer->stats.draw_us;
+    }
+}
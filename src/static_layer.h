@@ -0,0 +1,55 @@
+/*
+ *  SPDX-License-Identifier: LGPL-2.1-or-later
+ *
+ *  Xiegu X6100 LVGL GUI
+ *
+ *  Copyright (c) 2024 Georgy Dyuldin aka R2RFE
+ */
+
+#pragma once
+
+#include "lvgl/lvgl.h"
+
+#include <stdint.h>
+
+/**
+ * Cached static part of custom drawn widgets (scales, grids, labels).
+ *
+ * Static part is rendered once into ARGB image of widget size, then each
+ * draw only blits this image and the widget draws its dynamic part on top.
+ * Layer is rendered again after invalidate, on widget resize, on theme and
+ * band change.
+ */
+typedef struct static_layer_s * static_layer_t;
+
+/**
+ * Draw static part, coords are layer area with origin at 0, 0
+ */
+typedef void (*static_layer_draw_cb_t)(lv_draw_ctx_t *draw_ctx, const lv_area_t *coords);
+
+typedef struct {
+    uint32_t    renders;
+    uint64_t    render_us;      /* Total time of static part rendering */
+    uint32_t    draws;
+    uint64_t    draw_us;        /* Total time of blits */
+} static_layer_stats_t;
+
+static_layer_t static_layer_create(const char *name, static_layer_draw_cb_t cb);
+void static_layer_destroy(static_layer_t layer);
+
+void static_layer_invalidate(static_layer_t layer);
+
+/**
+ * Theme or band is changed
+ */
+void static_layer_invalidate_all();
+
+/**
+ * Blit static part to widget coords, render it before if needed
+ */
+void static_layer_draw(static_layer_t layer, lv_draw_ctx_t *draw_ctx, const lv_area_t *coords);
+
+/**
+ * Stats since creation, sum of all layers with NULL layer
+ */
+void static_layer_get_stats(static_layer_t layer, static_layer_stats_t *stats);
@@ -8,7 +8,8 @@
 
 #include "styles.h"
 
-#define PATH "A:/usr/share/x6100/"
+#include "static_layer.h"
+#include "assets.h"
 
 const uint32_t wf_palette_legacy[256] = {
     0x000000, 0x000004, 0x000008, 0x00000c, 0x00000e, 0x000012, 0x000016, 0x000018,
@@ -283,6 +284,7 @@ void styles_set_theme(themes_t theme) {
             setup_theme_simple();
             break;
     }
+    static_layer_invalidate_all();
 }
 
 static void setup_theme_legacy() {
@@ -291,26 +293,26 @@ static void setup_theme_legacy() {
     bg_color = lv_color_hex(0x0040A0);
     lv_style_set_bg_color(&background_style, bg_color);
 
-    lv_style_set_bg_img_src(&btn_style, PATH "images/btn.bin");
-    lv_style_set_bg_img_src(&msg_style, PATH "images/msg.bin");
+    lv_style_set_bg_img_src(&btn_style, assets_img("btn"));
+    lv_style_set_bg_img_src(&msg_style, assets_img("msg"));
     /* Clock */
-    lv_style_set_bg_img_src(&clock_style, PATH "images/top_short.bin");
+    lv_style_set_bg_img_src(&clock_style, assets_img("top_short"));
     lv_style_set_width(&clock_style, 206);
     lv_style_set_height(&clock_style, 61);
     /* Info */
-    lv_style_set_bg_img_src(&info_style, PATH "images/top_short.bin");
+    lv_style_set_bg_img_src(&info_style, assets_img("top_short"));
     lv_style_set_width(&info_style, 206);
     lv_style_set_height(&info_style, 61);
     /* Meter */
-    lv_style_set_bg_img_src(&meter_style, PATH "images/top_long.bin");
+    lv_style_set_bg_img_src(&meter_style, assets_img("top_long"));
     lv_style_set_width(&meter_style, 377);
     lv_style_set_height(&meter_style, 61);
 
-    lv_style_set_bg_img_src(&pannel_style, PATH "images/panel.bin");
-    lv_style_set_bg_img_src(&msg_tiny_style, PATH "images/msg_tiny.bin");
-    lv_style_set_bg_img_src(&dialog_style, PATH "images/dialog.bin");
+    lv_style_set_bg_img_src(&pannel_style, assets_img("panel"));
+    lv_style_set_bg_img_src(&msg_tiny_style, assets_img("msg_tiny"));
+    lv_style_set_bg_img_src(&dialog_style, assets_img("dialog"));
     /* TX info */
-    lv_style_set_bg_img_src(&tx_info_style, PATH "images/top_big.bin");
+    lv_style_set_bg_img_src(&tx_info_style, assets_img("top_big"));
     lv_style_set_width(&tx_info_style, 377);
     lv_style_set_height(&tx_info_style, 123);
 
@@ -323,26 +325,26 @@ static void setup_theme_simple() {
     bg_color = lv_color_hex(0x27313a);
     lv_style_set_bg_color(&background_style, bg_color);
 
-    lv_style_set_bg_img_src(&btn_style, PATH "images/btn_dark.bin");
-    lv_style_set_bg_img_src(&msg_style, PATH "images/msg_dark.bin");
+    lv_style_set_bg_img_src(&btn_style, assets_img("btn_dark"));
+    lv_style_set_bg_img_src(&msg_style, assets_img("msg_dark"));
     /* Clock */
-    lv_style_set_bg_img_src(&clock_style, PATH "images/top_short_dark.bin");
+    lv_style_set_bg_img_src(&clock_style, assets_img("top_short_dark"));
     lv_style_set_width(&clock_style, 209);
     lv_style_set_height(&clock_style, 61);
     /* Info */
-    lv_style_set_bg_img_src(&info_style, PATH "images/top_short_dark.bin");
+    lv_style_set_bg_img_src(&info_style, assets_img("top_short_dark"));
     lv_style_set_width(&info_style, 209);
     lv_style_set_height(&info_style, 61);
     /* Meter */
-    lv_style_set_bg_img_src(&meter_style, PATH "images/top_long_dark.bin");
+    lv_style_set_bg_img_src(&meter_style, assets_img("top_long_dark"));
     lv_style_set_width(&meter_style, 380);
     lv_style_set_height(&meter_style, 61);
 
-    lv_style_set_bg_img_src(&pannel_style, PATH "images/panel_dark.bin");
-    lv_style_set_bg_img_src(&msg_tiny_style, PATH "images/msg_tiny_dark.bin");
-    lv_style_set_bg_img_src(&dialog_style, PATH "images/dialog_dark.bin");
+    lv_style_set_bg_img_src(&pannel_style, assets_img("panel_dark"));
+    lv_style_set_bg_img_src(&msg_tiny_style, assets_img("msg_tiny_dark"));
+    lv_style_set_bg_img_src(&dialog_style, assets_img("dialog_dark"));
     /* TX info */
-    lv_style_set_bg_img_src(&tx_info_style, PATH "images/top_big_dark.bin");
+    lv_style_set_bg_img_src(&tx_info_style, assets_img("top_big_dark"));
     lv_style_set_width(&tx_info_style, 380);
     lv_style_set_height(&tx_info_style, 123);
 
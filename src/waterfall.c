@@ -19,14 +19,25 @@
 #include "util.h"
 #include "pubsub_ids.h"
 #include "scheduler.h"
+#include "dsp/binmap.h"
+#include "dsp/palmap.h"
+#include "dsp/wfhist.h"
+#include "spsc_ring.h"
 
 #include <stdlib.h>
 #include <math.h>
 #include <stdio.h>
+#include <stdatomic.h>
 
-#define PX_BYTES    sizeof(lv_color_t)
-#define DEFAULT_MIN S4
-#define DEFAULT_MAX S9_20
+#define PX_BYTES        sizeof(lv_color_t)
+#define DEFAULT_MIN     S4
+#define DEFAULT_MAX     S9_20
+#define SCROLL_TAU_MS   300.0f
+#define ROWS_QUEUE      16
+
+#define HISTORY_ARENA   (8 * 1024 * 1024)   /* 5 min at 30 rows/s in the worst case */
+#define HISTORY_ROWS    16384
+#define HISTORY_STEP_MS 2000                /* Per MFK click */
 
 static lv_obj_t         *obj;
 static lv_obj_t         *img;
@@ -42,14 +53,61 @@ static int32_t          width_hz = 100000;
 static float            grid_min = DEFAULT_MIN;
 static float            grid_max = DEFAULT_MAX;
 
-static lv_img_dsc_t     *frame;
-static uint8_t          delay = 0;
+static atomic_uchar     delay = 0;
+
+/* Row handoff from DSP thread, never blocks: row is dropped if queue is full */
+typedef struct {
+    int64_t     freq;
+    int32_t     span;
+    uint8_t     bins[];
+} row_t;
+
+static _Atomic spsc_ring_t rows_queue = NULL;   /* Published after row buffers */
+static atomic_bool      refresh_pending = false;
 
+/* UI thread only.
+ * Rows of width bins, each one covers its own span around its own center.
+ * Ring, newest row is last_row_id, older ones follow it */
 static int64_t          *freq_offsets;
+static int32_t          *row_spans;
 static uint16_t         last_row_id;
+static uint32_t         rows_put = 0;
 static uint8_t          *waterfall_cache;
 
-static int64_t          radio_center_freq = 0;
+/* Compressed rows that scrolled off, and a page of them shown instead of
+ * the live cache. Page is linear, row 0 is the newest */
+static wfhist_t         history;
+static bool             history_on = false;
+static bool             history_dirty = false;
+static uint32_t         history_seq;
+static uint64_t         history_time;
+static uint8_t          *past_cache;
+static int64_t          *past_offsets;
+static int32_t          *past_spans;
+
+/* Pixels of cache rows, same ring layout. Shown from top_row by two blits */
+static lv_color_t       *frame;
+static uint16_t         top_row;
+static uint32_t         rows_rendered = 0;
+static bool             frame_dirty = true;
+
+/* View of rendered frame, full render on change */
+static int64_t          frame_center_freq;
+static int32_t          frame_view_hz;
+static const uint32_t   *frame_palette;
+
+static int16_t          *mapping;
+static int32_t          mapping_span = 0;
+static int32_t          mapping_view_hz = 0;
+
+static bool             scroll_pending = false;
+static uint64_t         scroll_time;
+
+static binmap_t         row_map;
+static float            *row_buf;
+static palmap_t         row_palmap;
+
+static atomic_llong     radio_center_freq = 0;
 static int64_t          wf_center_freq = 0;
 
 static uint8_t          refresh_period = 1;
@@ -59,7 +117,7 @@ static uint8_t          zoom = 1;
 
 static void refresh_waterfall( void * arg);
 static void draw_middle_line();
-static void redraw_cb(lv_event_t * e);
+static void draw_cb(lv_event_t * e);
 static void zoom_changed_cd(void * s, lv_msg_t * m);
 
 
@@ -88,16 +146,43 @@ lv_obj_t * waterfall_init(lv_obj_t * parent, uint64_t cur_freq) {
 }
 
 static void scroll_down() {
-    last_row_id = (last_row_id + 1) % height;
+    last_row_id = (last_row_id + height - 1) % height;
 }
 
-void waterfall_data(float *data_buf, uint16_t size, bool tx) {
-    if (delay)
-    {
-        delay--;
+/**
+ * PSD of any size is reduced (or expanded) to width bins, so cache size
+ * does not depend on FFT size
+ */
+void waterfall_data(const float *data_buf, uint16_t size, int32_t span_hz, bool tx) {
+    spsc_ring_t queue = atomic_load_explicit(&rows_queue, memory_order_acquire);
+
+    if (!queue) {
+        return;
+    }
+
+    uint8_t d = atomic_load(&delay);
+
+    if (d) {
+        atomic_compare_exchange_strong(&delay, &d, d - 1);
+        return;
+    }
+
+    row_t *row = spsc_ring_write_begin(queue);
+
+    if (!row) {
         return;
     }
-    scroll_down();
+
+    if (size != width) {
+        if (!row_map || binmap_from_size(row_map) != size) {
+            if (row_map) {
+                binmap_destroy(row_map);
+            }
+            row_map = binmap_create(size, width);
+        }
+        binmap_execute(row_map, data_buf, row_buf, BINMAP_MAX);
+        data_buf = row_buf;
+    }
 
     float min, max;
     if (tx) {
@@ -108,33 +193,73 @@ void waterfall_data(float *data_buf, uint16_t size, bool tx) {
         max = grid_max;
     }
 
-    freq_offsets[last_row_id] = radio_center_freq + params_lo_offset_get();
+    row->freq = atomic_load(&radio_center_freq) + params_lo_offset_get();
+    row->span = span_hz;
 
-    for (uint16_t x = 0; x < size; x++) {
-        float       v = (data_buf[x] - min) / (max - min);
+    palmap_set_range(row_palmap, min, max);
+    palmap_execute_index(row_palmap, data_buf, width, row->bins, true);
+    spsc_ring_write_commit(queue);
 
-        if (v < 0.0f) {
-            v = 0.0f;
-        } else if (v > 1.0f) {
-            v = 1.0f;
-        }
+    if (!atomic_exchange(&refresh_pending, true)) {
+        scheduler_put(refresh_waterfall, NULL, 0);
+    }
+}
+
+/**
+ * Move queued rows to the cache, UI thread
+ */
+static void take_rows() {
+    spsc_ring_t queue = atomic_load_explicit(&rows_queue, memory_order_relaxed);
+    row_t       *row;
 
-        uint8_t id = v * 255;
-        waterfall_cache[last_row_id * size + size - 1 - x] = id;
+    while ((row = spsc_ring_read_begin(queue))) {
+        scroll_down();
+
+        freq_offsets[last_row_id] = row->freq;
+        row_spans[last_row_id] = row->span;
+        memcpy(&waterfall_cache[last_row_id * width], row->bins, width);
+        wfhist_put(history, row->bins, row->freq, row->span, get_time());
+        rows_put++;
+
+        spsc_ring_read_commit(queue);
+    }
+}
+
+/**
+ * One step of smooth scroll per drawn frame, speed does not depend on frame rate
+ */
+static void scroll_step(void * arg) {
+    uint64_t    now = get_time();
+    int64_t     target = atomic_load(&radio_center_freq);
+    int64_t     diff = target - wf_center_freq;
+
+    scroll_pending = false;
+
+    if (params.waterfall_smooth_scroll.x && llabs(diff) > 1) {
+        float   dt = LV_MIN(now - scroll_time, 100);
+        int64_t step = diff * (1.0f - expf(-dt / SCROLL_TAU_MS));
+
+        if (step == 0) {
+            step = diff > 0 ? 1 : -1;
+        }
+        wf_center_freq += step;
+    } else {
+        wf_center_freq = target;
     }
-    scheduler_put(refresh_waterfall, NULL, 0);
+
+    scroll_time = now;
+    refresh_waterfall(NULL);
 }
 
 static void do_scroll_cb(lv_event_t * event) {
     if (wf_center_freq == radio_center_freq) {
+        scroll_time = get_time();
         return;
     }
-    if (params.waterfall_smooth_scroll.x) {
-        wf_center_freq += (radio_center_freq - wf_center_freq) / 10 + 1;
-    } else {
-        wf_center_freq = radio_center_freq;
+    if (!scroll_pending) {
+        scroll_pending = true;
+        scheduler_put(scroll_step, NULL, 0);
     }
-    scheduler_put(refresh_waterfall, NULL, 0);
 }
 
 void waterfall_set_height(lv_coord_t h) {
@@ -147,19 +272,36 @@ void waterfall_set_height(lv_coord_t h) {
     width = 800;
     height = lv_obj_get_height(obj);
 
-    frame = lv_img_buf_alloc(width, height, LV_IMG_CF_TRUE_COLOR);
+    frame = malloc(width * height * PX_BYTES);
+    memset(frame, 0, width * height * PX_BYTES);
+    mapping = malloc(width * sizeof(*mapping));
 
-    img = lv_img_create(obj);
+    img = lv_obj_create(obj);
+    lv_obj_remove_style_all(img);
+    lv_obj_clear_flag(img, LV_OBJ_FLAG_SCROLLABLE | LV_OBJ_FLAG_CLICKABLE);
+    lv_obj_set_size(img, width, height);
     lv_obj_align(img, LV_ALIGN_CENTER, 0, 0);
-    lv_img_set_src(img, frame);
+    lv_obj_add_event_cb(img, draw_cb, LV_EVENT_DRAW_MAIN, NULL);
 
     freq_offsets = malloc(height * sizeof(*freq_offsets));
+    row_spans = malloc(height * sizeof(*row_spans));
     for (size_t i = 0; i < height; i++) {
         freq_offsets[i] = radio_center_freq;
+        row_spans[i] = width_hz;
     }
     last_row_id = 0;
-    waterfall_cache = malloc(WATERFALL_NFFT * height);
-    memset(waterfall_cache, 0, WATERFALL_NFFT * height);
+    top_row = 0;
+    waterfall_cache = malloc(width * height);
+    memset(waterfall_cache, 0, width * height);
+
+    history = wfhist_create(HISTORY_ARENA, HISTORY_ROWS, width);
+    past_cache = malloc(width * height);
+    past_offsets = malloc(height * sizeof(*past_offsets));
+    past_spans = malloc(height * sizeof(*past_spans));
+    row_buf = malloc(width * sizeof(float));
+    row_palmap = palmap_create(grid_min, grid_max);
+    atomic_store_explicit(&rows_queue, spsc_ring_create((sizeof(row_t) + width + 7) & ~7, ROWS_QUEUE),
+                          memory_order_release);
 
     lv_obj_add_event_cb(img, do_scroll_cb, LV_EVENT_DRAW_POST_END, NULL);
 
@@ -231,8 +373,8 @@ void waterfall_update_min(float db) {
 }
 
 void waterfall_set_freq(uint64_t freq) {
-    delay = 2;
-    radio_center_freq = freq;
+    atomic_store(&delay, 2);
+    atomic_store(&radio_center_freq, freq);
 }
 
 void waterfall_refresh_reset() {
@@ -246,47 +388,131 @@ void waterfall_refresh_period_set(uint8_t k) {
     refresh_period = k;
 }
 
-static void redraw_cb(lv_event_t * e) {
-    int32_t src_x_offset;
-    uint16_t src_y, src_x, dst_y, dst_x;
-
-    uint8_t * temp_buf = (uint8_t *)frame->data;
+static int32_t view_hz() {
+    return params.waterfall_zoom.x ? width_hz / zoom : width_hz;
+}
 
-    uint8_t current_zoom = 1;
-    if (params.waterfall_zoom.x) {
-        current_zoom = zoom;
+/**
+ * Mapping of pixels to row bins depends on row span, rows mostly share it
+ */
+static void update_mapping(int32_t span, int32_t view) {
+    if (span == mapping_span && view == mapping_view_hz) {
+        return;
     }
 
-    lv_color_t black = lv_color_black();
-    lv_color_t px_color;
+    float k = (float) view / span;
 
-    int16_t mapping[width];
-    float rel_position;
     for (uint16_t i = 0; i < width; i++) {
-        rel_position = (((float) i + 0.5) / width) - 0.5f;
-        mapping[i] = roundf(((rel_position / current_zoom) + 0.5f) * WATERFALL_NFFT - 1.0f);
+        float rel_position = (((float) i + 0.5f) / width) - 0.5f;
+
+        mapping[i] = floorf((rel_position * k + 0.5f) * width);
+    }
+
+    mapping_span = span;
+    mapping_view_hz = view;
+}
+
+static void render_row(uint16_t row) {
+    int32_t         span = history_on ? past_spans[row] : row_spans[row];
+    int64_t         freq = history_on ? past_offsets[row] : freq_offsets[row];
+    const uint8_t   *src = &(history_on ? past_cache : waterfall_cache)[row * width];
+    lv_color_t      *dst = &frame[row * width];
+    lv_color_t      black = lv_color_black();
+
+    if (span == 0) {
+        for (uint16_t dst_x = 0; dst_x < width; dst_x++) {
+            dst[dst_x] = black;
+        }
+        return;
     }
 
-    for (src_y = 0; src_y < height; src_y++) {
-        dst_y = ((height - src_y + last_row_id) % height);
-        src_x_offset = (freq_offsets[src_y] - wf_center_freq) * WATERFALL_NFFT / width_hz;
-        for (dst_x = 0; dst_x < width; dst_x++) {
-            src_x = mapping[dst_x] - src_x_offset;
-            if ((src_x < 0) || (src_x >= WATERFALL_NFFT)) {
-                px_color = black;
-            } else {
-                px_color = (lv_color_t)wf_palette[*(waterfall_cache + (src_y * WATERFALL_NFFT + src_x))];
+    int32_t         src_x_offset = (freq - frame_center_freq) * width / span;
+
+    update_mapping(span, frame_view_hz);
+
+    for (uint16_t dst_x = 0; dst_x < width; dst_x++) {
+        int32_t src_x = mapping[dst_x] - src_x_offset;
+
+        if ((src_x < 0) || (src_x >= width)) {
+            dst[dst_x] = black;
+        } else {
+            dst[dst_x] = (lv_color_t) frame_palette[src[src_x]];
+        }
+    }
+}
+
+/**
+ * Only new rows, unless the view of the frame is changed
+ */
+static void render() {
+    int32_t     view = view_hz();
+    uint32_t    rows = rows_put;
+    bool        changed = frame_center_freq != wf_center_freq || frame_view_hz != view || frame_palette != wf_palette;
+
+    if (history_on) {
+        if (changed || history_dirty) {
+            frame_center_freq = wf_center_freq;
+            frame_view_hz = view;
+            frame_palette = wf_palette;
+
+            for (uint16_t row = 0; row < height; row++) {
+                render_row(row);
             }
-            *((lv_color_t*)temp_buf + (dst_y * width + dst_x)) = px_color;
+            history_dirty = false;
         }
+        top_row = 0;
+        frame_dirty = true;
+        return;
+    }
+
+    if (changed || frame_dirty || rows - rows_rendered >= height) {
+        frame_center_freq = wf_center_freq;
+        frame_view_hz = view;
+        frame_palette = wf_palette;
+        frame_dirty = false;
+
+        for (uint16_t row = 0; row < height; row++) {
+            render_row(row);
+        }
+    } else {
+        for (uint16_t row = last_row_id; row != top_row; row = (row + 1) % height) {
+            render_row(row);
+        }
+    }
+
+    top_row = last_row_id;
+    rows_rendered = rows;
+}
+
+/**
+ * Ring of rows starts at top_row, so the frame is drawn by two parts
+ */
+static void draw_cb(lv_event_t * e) {
+    lv_draw_ctx_t       *draw_ctx = lv_event_get_draw_ctx(e);
+    lv_draw_img_dsc_t   dsc;
+    lv_area_t           area;
+
+    lv_draw_img_dsc_init(&dsc);
+    lv_obj_get_coords(img, &area);
+
+    area.y2 = area.y1 + (height - top_row) - 1;
+    lv_draw_img_decoded(draw_ctx, &dsc, &area, (const uint8_t *) &frame[top_row * width], LV_IMG_CF_TRUE_COLOR);
+
+    if (top_row) {
+        area.y1 = area.y2 + 1;
+        area.y2 = area.y1 + top_row - 1;
+        lv_draw_img_decoded(draw_ctx, &dsc, &area, (const uint8_t *) frame, LV_IMG_CF_TRUE_COLOR);
     }
 }
 
 static void refresh_waterfall( void * arg) {
+    atomic_store(&refresh_pending, false);
+    take_rows();
+    render();
+
     refresh_counter++;
     if (refresh_counter >= refresh_period) {
         refresh_counter = 0;
-        redraw_cb(NULL);
         lv_obj_invalidate(img);
     }
 }
@@ -295,3 +521,43 @@ static void zoom_changed_cd(void * s, lv_msg_t * m) {
     zoom = *(uint16_t *) lv_msg_get_payload(m);
     lv_style_set_line_width(&middle_line_style, zoom / 2 + 2);
 }
+
+/**
+ * Page of history from history_seq down, rows out of the store are black
+ */
+static void load_history() {
+    for (uint16_t row = 0; row < height; row++) {
+        uint8_t *dst = &past_cache[row * width];
+
+        if (!wfhist_get(history, history_seq - row, dst, &past_offsets[row], &past_spans[row], NULL)) {
+            past_spans[row] = 0;
+        }
+    }
+    history_dirty = true;
+}
+
+int16_t waterfall_history_change(int16_t diff) {
+    uint32_t    next = wfhist_next(history);
+    uint64_t    newest;
+
+    if (next == wfhist_first(history) || !wfhist_get(history, next - 1, NULL, NULL, NULL, &newest)) {
+        return 0;
+    }
+
+    int64_t back = history_on ? (int64_t) (newest - history_time) : 0;
+
+    back -= (int64_t) diff * HISTORY_STEP_MS;
+
+    if (back <= 0) {
+        history_on = false;
+    } else {
+        history_time = newest - back;
+        history_seq = wfhist_find(history, history_time);
+        history_on = true;
+        load_history();
+    }
+
+    refresh_waterfall(NULL);
+
+    return history_on ? (back + 500) / 1000 : 0;
+}
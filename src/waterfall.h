@@ -14,7 +14,10 @@
 #include "lvgl/lvgl.h"
 
 lv_obj_t * waterfall_init(lv_obj_t * parent, uint64_t cur_freq);
-void waterfall_data(float *data_buf, uint16_t size, bool tx);
+/**
+ * Row of PSD, size bins over span_hz around current frequency
+ */
+void waterfall_data(const float *data_buf, uint16_t size, int32_t span_hz, bool tx);
 void waterfall_set_height(lv_coord_t h);
 void waterfall_min_max_reset();
 
@@ -25,3 +28,9 @@ void waterfall_update_min(float db);
 void waterfall_set_freq(uint64_t freq);
 void waterfall_refresh_reset();
 void waterfall_refresh_period_set(uint8_t k);
+
+/**
+ * Move view of history by diff steps (negative - back in time). Return
+ * seconds back from the newest row, 0 is the live view
+ */
+int16_t waterfall_history_change(int16_t diff);
@@ -15,12 +15,17 @@
  *********************/
 #define MY_CLASS &lv_waterfall_class
 
+/* Palette map gives colors as 32 bit words */
+_Static_assert(sizeof(lv_color_t) == sizeof(uint32_t), "LV_COLOR_DEPTH 32 is expected");
+
 /**********************
  *  STATIC PROTOTYPES
  **********************/
 
 static void lv_waterfall_constructor(const lv_obj_class_t * class_p, lv_obj_t * obj);
 static void lv_waterfall_destructor(const lv_obj_class_t * class_p, lv_obj_t * obj);
+static void lv_waterfall_event(const lv_obj_class_t * class_p, lv_event_t * e);
+static void refresh_timer(lv_timer_t * t);
 
 /**********************
  *  STATIC VARIABLES
@@ -29,7 +34,8 @@ static void lv_waterfall_destructor(const lv_obj_class_t * class_p, lv_obj_t * o
 const lv_obj_class_t lv_waterfall_class  = {
     .constructor_cb = lv_waterfall_constructor,
     .destructor_cb = lv_waterfall_destructor,
-    .base_class = &lv_img_class,
+    .event_cb = lv_waterfall_event,
+    .base_class = &lv_obj_class,
     .instance_size = sizeof(lv_waterfall_t),
 };
 
@@ -52,13 +58,12 @@ lv_obj_t * lv_waterfall_create(lv_obj_t * parent) {
 void lv_waterfall_set_palette(lv_obj_t * obj, lv_color_t * palette, uint16_t cnt) {
     LV_ASSERT_OBJ(obj, MY_CLASS);
     LV_ASSERT_NULL(palette);
+    LV_ASSERT(cnt == 256);
 
     lv_waterfall_t * waterfall = (lv_waterfall_t *)obj;
 
-    waterfall->palette = lv_mem_realloc(waterfall->palette, cnt * sizeof(waterfall->palette[0]));
-    waterfall->palette_cnt = cnt;
-
-    memcpy(waterfall->palette, palette, cnt * sizeof(waterfall->palette[0]));
+    palmap_set_palette(waterfall->palmap, (const uint32_t *) palette);
+    waterfall->palette_set = true;
 }
 
 void lv_waterfall_set_size(lv_obj_t * obj, lv_coord_t w, lv_coord_t h) {
@@ -68,14 +73,17 @@ void lv_waterfall_set_size(lv_obj_t * obj, lv_coord_t w, lv_coord_t h) {
 
     lv_waterfall_t * waterfall = (lv_waterfall_t *)obj;
 
-    waterfall->dsc = lv_img_buf_alloc(w, h, LV_IMG_CF_TRUE_COLOR);
-    memset(waterfall->dsc->data, 0, waterfall->dsc->data_size);
+    if (waterfall->buf) lv_mem_free(waterfall->buf);
 
-    waterfall->line_len = waterfall->dsc->data_size / waterfall->dsc->header.h;
-    waterfall->line_buf = lv_mem_realloc(waterfall->line_buf, waterfall->line_len);
+    waterfall->buf = lv_mem_alloc(w * h * sizeof(lv_color_t));
+    memset(waterfall->buf, 0, w * h * sizeof(lv_color_t));
 
-    lv_img_set_src(obj, waterfall->dsc);
-    lv_img_cache_invalidate_src(waterfall->dsc);
+    waterfall->w = w;
+    waterfall->h = h;
+    atomic_store(&waterfall->top, 0);
+
+    waterfall->line_buf = lv_mem_realloc(waterfall->line_buf, w * sizeof(float));
+    lv_obj_invalidate(obj);
 }
 
 void lv_waterfall_clear_data(lv_obj_t * obj) {
@@ -83,43 +91,37 @@ void lv_waterfall_clear_data(lv_obj_t * obj) {
 
     lv_waterfall_t * waterfall = (lv_waterfall_t *)obj;
 
-    memset(waterfall->dsc->data, 0, waterfall->dsc->data_size);
-    lv_img_cache_invalidate_src(waterfall->dsc);
+    if (waterfall->buf) {
+        memset(waterfall->buf, 0, waterfall->w * waterfall->h * sizeof(lv_color_t));
+        lv_obj_invalidate(obj);
+    }
 }
 
 void lv_waterfall_add_data(lv_obj_t * obj, float * data, uint16_t cnt) {
     LV_ASSERT_OBJ(obj, MY_CLASS);
 
     lv_waterfall_t  *waterfall = (lv_waterfall_t *)obj;
-    lv_img_dsc_t    *dsc = waterfall->dsc;
 
-    if (!dsc || !waterfall->palette) {
+    if (!waterfall->buf || !waterfall->palette_set) {
         return;
     }
 
-    uint32_t        line_len = waterfall->line_len;
+    lv_coord_t  w = waterfall->w;
+    lv_coord_t  h = waterfall->h;
 
-    /* Scroll down */
+    /* Oldest row becomes the newest one */
 
-    memmove(dsc->data + line_len, dsc->data, dsc->data_size - line_len);
+    int top = (atomic_load(&waterfall->top) + h - 1) % h;
 
-    /* Paint */
-
-    for (uint32_t x = 0; x < dsc->header.w; x++) {
-        uint32_t    index = x * cnt / dsc->header.w;
-        float       d = data[index];
-        float       v = (d - waterfall->min) / (waterfall->max - waterfall->min);
-
-        if (v < 0.0f) {
-            v = 0.0f;
-        } else if (v > 1.0f) {
-            v = 1.0f;
-        }
+    for (lv_coord_t x = 0; x < w; x++) {
+        waterfall->line_buf[x] = data[x * cnt / w];
+    }
 
-        uint8_t id = v * 255;
+    palmap_set_range(waterfall->palmap, waterfall->min, waterfall->max);
+    palmap_execute_color(waterfall->palmap, waterfall->line_buf, w, (uint32_t *) &waterfall->buf[top * w]);
 
-        lv_img_buf_set_px_color(dsc, x, 0, waterfall->palette[id]);
-    }
+    atomic_store(&waterfall->top, top);
+    atomic_fetch_add(&waterfall->lines, 1);
 }
 
 void lv_waterfall_set_min(lv_obj_t * obj, int16_t val) {
@@ -143,12 +145,18 @@ static void lv_waterfall_constructor(const lv_obj_class_t * class_p, lv_obj_t *
 
     lv_waterfall_t * waterfall = (lv_waterfall_t *)obj;
 
-    waterfall->palette = NULL;
-    waterfall->palette_cnt = 0;
-    waterfall->line_len = 0;
+    waterfall->palette_set = false;
+    waterfall->buf = NULL;
+    waterfall->w = 0;
+    waterfall->h = 0;
+    atomic_init(&waterfall->top, 0);
+    atomic_init(&waterfall->lines, 0);
+    waterfall->lines_drawn = 0;
     waterfall->line_buf = NULL;
     waterfall->min = -40;
     waterfall->max = 0;
+    waterfall->palmap = palmap_create(waterfall->min, waterfall->max);
+    waterfall->timer = lv_timer_create(refresh_timer, LV_DISP_DEF_REFR_PERIOD, obj);
 
     LV_TRACE_OBJ_CREATE("finished");
 }
@@ -157,6 +165,58 @@ static void lv_waterfall_destructor(const lv_obj_class_t * class_p, lv_obj_t * o
     LV_UNUSED(class_p);
     lv_waterfall_t * waterfall = (lv_waterfall_t *)obj;
 
-    if (waterfall->palette) lv_mem_free(waterfall->palette);
+    lv_timer_del(waterfall->timer);
+    palmap_destroy(waterfall->palmap);
+    if (waterfall->buf) lv_mem_free(waterfall->buf);
     if (waterfall->line_buf) lv_mem_free(waterfall->line_buf);
 }
+
+static void lv_waterfall_event(const lv_obj_class_t * class_p, lv_event_t * e) {
+    LV_UNUSED(class_p);
+
+    lv_res_t res = lv_obj_event_base(MY_CLASS, e);
+
+    if (res != LV_RES_OK) return;
+
+    lv_event_code_t code = lv_event_get_code(e);
+    lv_obj_t * obj = lv_event_get_target(e);
+
+    if (code == LV_EVENT_DRAW_MAIN) {
+        lv_waterfall_t      *waterfall = (lv_waterfall_t *) obj;
+        lv_draw_ctx_t       *draw_ctx = lv_event_get_draw_ctx(e);
+        lv_draw_img_dsc_t   dsc;
+        lv_area_t           area;
+
+        if (!waterfall->buf) return;
+
+        int         top = atomic_load(&waterfall->top);
+        lv_coord_t  w = waterfall->w;
+        lv_coord_t  h = waterfall->h;
+
+        lv_draw_img_dsc_init(&dsc);
+        lv_obj_get_content_coords(obj, &area);
+
+        area.x2 = area.x1 + w - 1;
+        area.y2 = area.y1 + (h - top) - 1;
+        lv_draw_img_decoded(draw_ctx, &dsc, &area, (const uint8_t *) &waterfall->buf[top * w], LV_IMG_CF_TRUE_COLOR);
+
+        if (top) {
+            area.y1 = area.y2 + 1;
+            area.y2 = area.y1 + top - 1;
+            lv_draw_img_decoded(draw_ctx, &dsc, &area, (const uint8_t *) waterfall->buf, LV_IMG_CF_TRUE_COLOR);
+        }
+    }
+}
+
+/**
+ * Lines are added from other threads, so the widget is invalidated here
+ */
+static void refresh_timer(lv_timer_t * t) {
+    lv_waterfall_t  *waterfall = t->user_data;
+    unsigned int    lines = atomic_load(&waterfall->lines);
+
+    if (lines != waterfall->lines_drawn) {
+        waterfall->lines_drawn = lines;
+        lv_obj_invalidate((lv_obj_t *) waterfall);
+    }
+}
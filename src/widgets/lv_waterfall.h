@@ -16,20 +16,34 @@ extern "C" {
  *********************/
 
 #include "lvgl/lvgl.h"
+#include "dsp/palmap.h"
+
+#include <stdatomic.h>
 
 /**********************
  *      TYPEDEFS
  **********************/
 
+/**
+ * Lines are kept in a ring, newest line is at top. Adding a line writes one row
+ * and moves the top, so the image is drawn by two parts. Lines may be added from
+ * any thread, the widget invalidates itself from LVGL timer
+ */
 typedef struct {
-    lv_img_t        obj;
-    lv_img_dsc_t    *dsc;
+    lv_obj_t        obj;
+
+    lv_color_t      *buf;
+    lv_coord_t      w;
+    lv_coord_t      h;
+    atomic_int      top;
+    atomic_uint     lines;
+    unsigned int    lines_drawn;
+    lv_timer_t      *timer;
 
-    uint32_t        line_len;
-    uint8_t         *line_buf;
+    float           *line_buf;
 
-    lv_color_t      *palette;
-    uint16_t        palette_cnt;
+    palmap_t        palmap;
+    bool            palette_set;
 
     int16_t         min;
     int16_t         max;
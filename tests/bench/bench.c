@@ -0,0 +1,748 @@
+/*
+ *  SPDX-License-Identifier: LGPL-2.1-or-later
+ *
+ *  Xiegu X6100 LVGL GUI
+ *
+ *  Copyright (c) 2024 Georgy Dyuldin aka R2RFE
+ */
+
+/*
+ * Host benchmark of GUI DSP modules.
+ *
+ * Stages are run on IQ/audio fixtures (recorded .sigmf-data and raw s16le
+ * 44100 Hz mono audio) or on synthetic signals. Result is printed as JSON:
+ * ns/sample, realtime factor, produced frames and heap allocations of each
+ * stage. Widget stages report lines/s as frames_per_s, spectrum drawing
+ * stages report frames/s of the old lv_draw_line path and of specdraw,
+ * display stages compare LVGL sw_rotate with rotation into native page.
+ *
+ *   bench [--iq file.sigmf-data] [--audio file.raw] [--seconds N] [--rows N]
+ */
+
+#include "stubs.h"
+
+#include "params/params.h"
+#include "dsp.h"
+#include "cw.h"
+#include "rtty.h"
+#include "radio.h"
+#include "audio.h"
+#include "waterfall.h"
+#include "display.h"
+#include "ft8/worker.h"
+#include "dsp/iqfile.h"
+#include "dsp/binmap.h"
+#include "dsp/specdraw.h"
+#include "simd/simd.h"
+#include "widgets/lv_waterfall.h"
+
+#include "lvgl/lvgl.h"
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#define IQ_RATE         100000
+#define FT8_RATE        (AUDIO_CAPTURE_RATE / 6)
+#define AUDIO_BLOCK     882         /* 20 ms */
+#define DSP_QUEUE       24          /* Keep DSP thread busy, but never overrun */
+#define DISP_WIDTH      800
+#define DISP_HEIGHT     480
+#define WATERFALL_H     250
+#define FT8_WF_WIDTH    771
+#define FT8_WF_BINS     450         /* Filter passband of FT8 dialog */
+#define SPECTRUM_H      130
+#define SPECTRUM_POINTS 800
+
+typedef struct {
+    const char  *name;
+    size_t      samples;
+    uint32_t    rate;
+    uint64_t    ns;
+    size_t      frames;
+    size_t      allocs;
+} stage_t;
+
+static stage_t          stages[32];
+static size_t           stages_count = 0;
+
+/* Allocations counter, malloc family is wrapped by linker */
+
+static atomic_size_t    allocs = 0;
+
+void * __real_malloc(size_t size);
+void * __real_calloc(size_t n, size_t size);
+void * __real_realloc(void *ptr, size_t size);
+
+void * __wrap_malloc(size_t size) {
+    atomic_fetch_add_explicit(&allocs, 1, memory_order_relaxed);
+    return __real_malloc(size);
+}
+
+void * __wrap_calloc(size_t n, size_t size) {
+    atomic_fetch_add_explicit(&allocs, 1, memory_order_relaxed);
+    return __real_calloc(n, size);
+}
+
+void * __wrap_realloc(void *ptr, size_t size) {
+    atomic_fetch_add_explicit(&allocs, 1, memory_order_relaxed);
+    return __real_realloc(ptr, size);
+}
+
+/* Helpers */
+
+static uint64_t now_ns() {
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+
+    return (uint64_t) now.tv_sec * 1000000000L + now.tv_nsec;
+}
+
+static uint32_t rnd_state = 0x12345678;
+
+static float noise() {
+    /* xorshift32, uniform [-1, 1) */
+    rnd_state ^= rnd_state << 13;
+    rnd_state ^= rnd_state >> 17;
+    rnd_state ^= rnd_state << 5;
+
+    return (float) rnd_state / 2147483648.0f - 1.0f;
+}
+
+static stage_t * stage_begin(const char *name, size_t samples, uint32_t rate) {
+    stage_t *s = &stages[stages_count++];
+
+    s->name = name;
+    s->samples = samples;
+    s->rate = rate;
+    s->frames = 0;
+    s->allocs = atomic_load(&allocs);
+    s->ns = now_ns();
+
+    return s;
+}
+
+static void stage_end(stage_t *s, size_t frames) {
+    s->ns = now_ns() - s->ns;
+    s->allocs = atomic_load(&allocs) - s->allocs;
+    s->frames = frames;
+}
+
+/* Fixtures */
+
+static float complex * load_iq(const char *path, size_t *count) {
+    iqfile_t f = iqfile_open(path);
+
+    if (!f) {
+        fprintf(stderr, "Can't open %s\n", path);
+        exit(1);
+    }
+
+    size_t          cap = IQ_RATE;
+    float complex   *buf = malloc(cap * sizeof(float complex));
+    iqfile_packet_t packet;
+
+    *count = 0;
+
+    while (true) {
+        if (*count + RADIO_SAMPLES > cap) {
+            cap *= 2;
+            buf = realloc(buf, cap * sizeof(float complex));
+        }
+        if (!iqfile_read(f, &packet, &buf[*count], RADIO_SAMPLES)) {
+            break;
+        }
+        *count += packet.count;
+    }
+
+    iqfile_close(f);
+    return buf;
+}
+
+static float complex * synth_iq(float seconds, size_t *count) {
+    static const struct {
+        float   freq;
+        float   amp;
+    } tones[] = {
+        { -31000.0f, 1e-2f }, { -7300.0f, 1e-4f }, { 1500.0f, 3e-3f }, { 12000.0f, 1e-5f }, { 40100.0f, 3e-4f }
+    };
+
+    *count = (size_t) (seconds * IQ_RATE) / RADIO_SAMPLES * RADIO_SAMPLES;
+
+    float complex *buf = malloc(*count * sizeof(float complex));
+
+    for (size_t i = 0; i < *count; i++) {
+        float complex x = (noise() + noise() * I) * 1e-5f;
+
+        for (size_t t = 0; t < sizeof(tones) / sizeof(tones[0]); t++) {
+            x += tones[t].amp * cexpf(I * 2.0f * M_PI * tones[t].freq * i / IQ_RATE);
+        }
+        buf[i] = x;
+    }
+    return buf;
+}
+
+static int16_t * load_audio(const char *path, size_t *count) {
+    FILE *f = fopen(path, "rb");
+
+    if (!f) {
+        fprintf(stderr, "Can't open %s\n", path);
+        exit(1);
+    }
+
+    fseek(f, 0, SEEK_END);
+    *count = ftell(f) / sizeof(int16_t);
+    fseek(f, 0, SEEK_SET);
+
+    int16_t *buf = malloc(*count * sizeof(int16_t));
+
+    *count = fread(buf, sizeof(int16_t), *count, f);
+    fclose(f);
+
+    return buf;
+}
+
+static void add_tone(int16_t *buf, size_t from, size_t to, float freq, float amp) {
+    for (size_t i = from; i < to; i++) {
+        buf[i] += amp * sinf(2.0f * M_PI * freq * i / AUDIO_CAPTURE_RATE);
+    }
+}
+
+static int16_t * audio_noise(float seconds, size_t *count) {
+    *count = seconds * AUDIO_CAPTURE_RATE;
+
+    int16_t *buf = malloc(*count * sizeof(int16_t));
+
+    for (size_t i = 0; i < *count; i++) {
+        buf[i] = noise() * 300.0f;
+    }
+    return buf;
+}
+
+/* "PARIS " at 20 WPM, 700 Hz */
+static int16_t * synth_cw(float seconds, size_t *count) {
+    static const char   *paris = ".--. .- .-. .. ... / ";
+    const size_t        dot = AUDIO_CAPTURE_RATE * 60 / 1000;
+    int16_t             *buf = audio_noise(seconds, count);
+    size_t              pos = 0;
+
+    while (true) {
+        for (const char *c = paris; *c; c++) {
+            size_t len = 0;
+
+            switch (*c) {
+                case '.':   len = dot;  break;
+                case '-':   len = dot * 3;  break;
+                case ' ':   pos += dot * 2;  continue;
+                case '/':   pos += dot * 4;  continue;
+            }
+
+            if (pos + len + dot > *count) {
+                return buf;
+            }
+            add_tone(buf, pos, pos + len, params.key_tone, 8000.0f);
+            pos += len + dot;
+        }
+    }
+}
+
+/* Random Baudot characters, 45.45 baud, continuous phase FSK */
+static int16_t * synth_rtty(float seconds, size_t *count) {
+    const float bit = AUDIO_CAPTURE_RATE * 100.0f / params.rtty_rate;
+    const float mark = params.rtty_center + params.rtty_shift / 2.0f;
+    const float space = params.rtty_center - params.rtty_shift / 2.0f;
+    int16_t     *buf = audio_noise(seconds, count);
+    float       phase = 0.0f;
+    float       pos = 0.0f;
+
+    while (pos + bit * 8 < *count) {
+        uint8_t c = (rnd_state >> 8) & 0x1F;
+        bool    bits[8] = { false, c & 1, c & 2, c & 4, c & 8, c & 16, true, true };
+
+        noise();
+
+        for (uint8_t b = 0; b < 8; b++) {
+            float freq = bits[b] ? mark : space;
+
+            for (size_t i = pos; i < (size_t) (pos + bit); i++) {
+                phase += 2.0f * M_PI * freq / AUDIO_CAPTURE_RATE;
+                buf[i] += 8000.0f * sinf(phase);
+            }
+            pos += bit;
+        }
+    }
+    return buf;
+}
+
+/* Stages */
+
+static void bench_dsp(float complex *iq, size_t count) {
+    atomic_store(&stub_spectrum_frames, 0);
+
+    stage_t *s = stage_begin("dsp_iq", count, IQ_RATE);
+
+    for (size_t i = 0; i + RADIO_SAMPLES <= count; i += RADIO_SAMPLES) {
+        while (dsp_get_queued() > DSP_QUEUE) {
+            usleep(50);
+        }
+        dsp_samples(&iq[i], RADIO_SAMPLES, false);
+    }
+
+    while (dsp_get_queued() > 0) {
+        usleep(50);
+    }
+
+    stage_end(s, atomic_load(&stub_spectrum_frames));
+}
+
+/**
+ * Spectrum FFT alone: spectrogram at 15 frames/s and remapping to display
+ * width. 800 is the old mixed radix path without remapping
+ */
+static void bench_spectrum_fft(const char *name, uint16_t nfft, float complex *iq, size_t count) {
+    spgramcf    sg = spgramcf_create(nfft, LIQUID_WINDOW_HANN, nfft, nfft / 4);
+    binmap_t    map = (nfft != SPECTRUM_SIZE) ? binmap_create(nfft, SPECTRUM_SIZE) : NULL;
+    float       *psd = malloc(nfft * sizeof(float));
+    float       *out = malloc(SPECTRUM_SIZE * sizeof(float));
+    size_t      frame = IQ_RATE / 15;
+    size_t      frames = 0;
+
+    spgramcf_set_alpha(sg, 0.4f);
+
+    stage_t *s = stage_begin(name, count, IQ_RATE);
+
+    for (size_t i = 0; i + RADIO_SAMPLES <= count; i += RADIO_SAMPLES) {
+        spgramcf_write(sg, &iq[i], RADIO_SAMPLES);
+
+        if ((i + RADIO_SAMPLES) / frame != i / frame) {
+            spgramcf_get_psd(sg, psd);
+
+            if (map) {
+                binmap_execute(map, psd, out, BINMAP_MAX);
+            }
+            frames++;
+        }
+    }
+
+    stage_end(s, frames);
+
+    if (map) {
+        binmap_destroy(map);
+    }
+    spgramcf_destroy(sg);
+    free(psd);
+    free(out);
+}
+
+static void bench_audio(const char *name, x6100_mode_t mode, rtty_state_t rtty, int16_t *audio, size_t count) {
+    stub_mode = mode;
+    rtty_set_state(rtty);
+    atomic_store(&stub_text_chars, 0);
+
+    stage_t *s = stage_begin(name, count, AUDIO_CAPTURE_RATE);
+
+    for (size_t i = 0; i + AUDIO_BLOCK <= count; i += AUDIO_BLOCK) {
+        dsp_put_audio_samples(AUDIO_BLOCK, &audio[i]);
+    }
+
+    stage_end(s, atomic_load(&stub_text_chars));
+    rtty_set_state(RTTY_OFF);
+}
+
+static void ft8_msg_cb(const char *text, int snr, float freq_hz, float time_sec, void *user_data) {
+    (*(size_t *) user_data)++;
+}
+
+static void bench_ft8() {
+    const size_t    slot = 15 * FT8_RATE;
+    float complex   *buf = calloc(slot, sizeof(float complex));
+    int16_t         *tx;
+    uint32_t        tx_count;
+
+    ftx_worker_init(FT8_RATE, FTX_PROTOCOL_FT8);
+
+    if (ftx_worker_generate_tx_samples("CQ K1ABC FN42", 1000, FT8_RATE, &tx, &tx_count)) {
+        for (size_t i = 0; i < tx_count && (i + FT8_RATE / 2) < slot; i++) {
+            buf[i + FT8_RATE / 2] = tx[i] / 32768.0f * 0.1f;
+        }
+        free(tx);
+    }
+    for (size_t i = 0; i < slot; i++) {
+        buf[i] += (noise() + noise() * I) * 0.01f;
+    }
+
+    int     block = ftx_worker_get_block_size();
+    size_t  decoded = 0;
+
+    stage_t *s = stage_begin("ft8", slot, FT8_RATE);
+
+    for (size_t i = 0; i + block <= slot; i += block) {
+        ftx_worker_put_rx_samples(&buf[i], block);
+
+        if (ftx_worker_is_full()) {
+            break;
+        }
+        ftx_worker_decode(ft8_msg_cb, false, &decoded);
+    }
+    ftx_worker_decode(ft8_msg_cb, true, &decoded);
+    ftx_worker_reset();
+
+    stage_end(s, decoded);
+
+    ftx_worker_free();
+    free(buf);
+}
+
+static void bench_waterfall(size_t rows) {
+    float *row = malloc(WATERFALL_NFFT * sizeof(float));
+
+    stub_run_scheduled = true;
+
+    stage_t *s = stage_begin("waterfall", rows * WATERFALL_NFFT, 0);
+
+    for (size_t r = 0; r < rows; r++) {
+        for (size_t i = 0; i < WATERFALL_NFFT; i++) {
+            row[i] = -110.0f + noise() * 5.0f + ((i + r) % 97 == 0 ? 50.0f : 0.0f);
+        }
+        waterfall_data(row, WATERFALL_NFFT, 100000, false);
+        lv_tick_inc(1000 / 25);
+        lv_refr_now(NULL);
+    }
+
+    stage_end(s, rows);
+    stub_run_scheduled = false;
+    free(row);
+}
+
+/* LVGL on memory framebuffer */
+
+/**
+ * FT8 dialog waterfall widget, each line is added and drawn
+ */
+static void bench_lv_waterfall(const char *name, lv_coord_t h, size_t lines) {
+    static const uint32_t   palette[256];
+    float                   *row = malloc(FT8_WF_BINS * sizeof(float));
+    lv_obj_t                *wf = lv_waterfall_create(lv_scr_act());
+
+    lv_waterfall_set_palette(wf, (lv_color_t *) palette, 256);
+    lv_waterfall_set_size(wf, FT8_WF_WIDTH, h);
+    lv_waterfall_set_min(wf, -60);
+    lv_refr_now(NULL);
+
+    stage_t *s = stage_begin(name, lines * FT8_WF_WIDTH, 0);
+
+    for (size_t r = 0; r < lines; r++) {
+        for (size_t i = 0; i < FT8_WF_BINS; i++) {
+            row[i] = -50.0f + noise() * 5.0f + ((i + r) % 97 == 0 ? 40.0f : 0.0f);
+        }
+        lv_waterfall_add_data(wf, row, FT8_WF_BINS);
+        lv_tick_inc(LV_DISP_DEF_REFR_PERIOD);
+        lv_timer_handler();
+    }
+
+    stage_end(s, lines);
+    lv_obj_del(wf);
+    free(row);
+}
+
+/* Spectrum traces, lv_draw_line per column as before or specdraw */
+
+typedef struct {
+    bool    raster;
+    bool    filled;
+    float   *main;
+    float   *peak;
+} spectrum_bench_t;
+
+static void spectrum_lines(lv_draw_ctx_t *draw_ctx, const lv_area_t *coords, const float *v, lv_color_t color, bool filled) {
+    lv_draw_line_dsc_t  dsc;
+    lv_point_t          a, b;
+    lv_coord_t          w = lv_area_get_width(coords);
+    lv_coord_t          h = lv_area_get_height(coords);
+
+    lv_draw_line_dsc_init(&dsc);
+    dsc.color = color;
+    dsc.width = 1;
+
+    b.x = coords->x1;
+    b.y = coords->y1 + h;
+
+    for (uint16_t i = 0; i < SPECTRUM_POINTS; i++) {
+        a.x = coords->x1 + i * w / SPECTRUM_POINTS;
+        a.y = coords->y1 + (1.0f - (v[i] + 120.0f) / 80.0f) * h;
+
+        if (filled) {
+            b.x = a.x;
+            b.y = coords->y1 + h;
+        }
+
+        lv_draw_line(draw_ctx, &dsc, &a, &b);
+
+        if (!filled) {
+            b = a;
+        }
+    }
+}
+
+static void spectrum_draw_cb(lv_event_t *e) {
+    spectrum_bench_t    *sb = lv_event_get_user_data(e);
+    lv_obj_t            *obj = lv_event_get_target(e);
+    lv_draw_ctx_t       *draw_ctx = lv_event_get_draw_ctx(e);
+    lv_color_t          main_color = lv_color_hex(0xAAAAAA);
+    lv_color_t          peak_color = lv_color_hex(0x555555);
+
+    if (!sb->raster) {
+        spectrum_lines(draw_ctx, &obj->coords, sb->peak, peak_color, false);
+        spectrum_lines(draw_ctx, &obj->coords, sb->main, main_color, sb->filled);
+        return;
+    }
+
+    specdraw_canvas_t   canvas = {
+        .buf = draw_ctx->buf,
+        .stride = lv_area_get_width(draw_ctx->buf_area),
+        .buf_x = draw_ctx->buf_area->x1,
+        .buf_y = draw_ctx->buf_area->y1,
+        .clip_x1 = draw_ctx->clip_area->x1,
+        .clip_y1 = draw_ctx->clip_area->y1,
+        .clip_x2 = draw_ctx->clip_area->x2,
+        .clip_y2 = draw_ctx->clip_area->y2
+    };
+
+    specdraw_area_t     area = {
+        .x = obj->coords.x1, .y = obj->coords.y1,
+        .w = lv_obj_get_width(obj), .h = lv_obj_get_height(obj),
+        .min = -120.0f, .max = -40.0f
+    };
+
+    specdraw_trace(&canvas, &area, sb->peak, SPECTRUM_POINTS, SPECDRAW_LINE, lv_color_to32(peak_color), LV_OPA_COVER);
+    specdraw_trace(&canvas, &area, sb->main, SPECTRUM_POINTS, sb->filled ? SPECDRAW_FILLED : SPECDRAW_LINE,
+                   lv_color_to32(main_color), LV_OPA_COVER);
+}
+
+/**
+ * Frame of main spectrum with peak trace, frames_per_s gives frame time
+ */
+static void bench_spectrum_draw(const char *name, bool raster, bool filled, size_t frames) {
+    spectrum_bench_t    sb = { .raster = raster, .filled = filled };
+    lv_obj_t            *obj = lv_obj_create(lv_scr_act());
+
+    sb.main = malloc(SPECTRUM_POINTS * sizeof(float));
+    sb.peak = malloc(SPECTRUM_POINTS * sizeof(float));
+
+    /* Opaque, so objects below are not redrawn */
+    lv_obj_remove_style_all(obj);
+    lv_obj_set_style_bg_color(obj, lv_color_black(), 0);
+    lv_obj_set_style_bg_opa(obj, LV_OPA_COVER, 0);
+    lv_obj_set_size(obj, DISP_WIDTH, SPECTRUM_H);
+    lv_obj_add_event_cb(obj, spectrum_draw_cb, LV_EVENT_DRAW_MAIN_END, &sb);
+    lv_refr_now(NULL);
+
+    stage_t *s = stage_begin(name, frames * SPECTRUM_POINTS, 0);
+
+    for (size_t f = 0; f < frames; f++) {
+        for (size_t i = 0; i < SPECTRUM_POINTS; i++) {
+            sb.main[i] = -100.0f + noise() * 10.0f + ((i + f) % 101 == 0 ? 40.0f : 0.0f);
+            sb.peak[i] = sb.main[i] + 6.0f;
+        }
+        lv_obj_invalidate(obj);
+        lv_refr_now(NULL);
+    }
+
+    stage_end(s, frames);
+    lv_obj_del(obj);
+    free(sb.main);
+    free(sb.peak);
+}
+
+/* Display pipeline: LVGL sw_rotate and copy as before, tiled rotation into native page */
+
+static lv_color_t   native_fb[DISPLAY_NATIVE_W * DISPLAY_NATIVE_H];
+
+static void native_fb_flush(lv_disp_drv_t *drv, const lv_area_t *area, lv_color_t *color_p) {
+    int32_t w = lv_area_get_width(area);
+
+    for (int32_t y = area->y1; y <= area->y2; y++, color_p += w) {
+        memcpy(&native_fb[y * DISPLAY_NATIVE_W + area->x1], color_p, w * sizeof(lv_color_t));
+    }
+
+    lv_disp_flush_ready(drv);
+}
+
+static uint32_t * native_fb_page(uint32_t *stride) {
+    *stride = DISPLAY_NATIVE_W;
+
+    return (uint32_t *) native_fb;
+}
+
+static lv_disp_t * display_sw_rotate() {
+    static lv_disp_draw_buf_t   draw_buf;
+    static lv_disp_drv_t        disp_drv;
+    lv_color_t                  *buf = malloc(DISPLAY_WIDTH * DISPLAY_HEIGHT * sizeof(lv_color_t));
+
+    lv_disp_draw_buf_init(&draw_buf, buf, NULL, DISPLAY_WIDTH * DISPLAY_HEIGHT);
+    lv_disp_drv_init(&disp_drv);
+
+    disp_drv.draw_buf = &draw_buf;
+    disp_drv.flush_cb = native_fb_flush;
+    disp_drv.hor_res = DISPLAY_NATIVE_W;
+    disp_drv.ver_res = DISPLAY_NATIVE_H;
+    disp_drv.sw_rotate = 1;
+    disp_drv.rotated = LV_DISP_ROT_90;
+
+    return lv_disp_drv_register(&disp_drv);
+}
+
+static lv_disp_t * display_native() {
+    static const display_backend_t backend = { .page = native_fb_page, .flush = native_fb_flush };
+
+    return display_init(&backend)->disp;
+}
+
+/**
+ * Frames of full screen or of waterfall sized band, frames_per_s gives frame time
+ */
+static void bench_display(const char *name, lv_disp_t *disp, bool full, size_t frames) {
+    lv_obj_t *scr = lv_disp_get_scr_act(disp);
+    lv_obj_t *band = lv_obj_create(scr);
+
+    lv_obj_set_style_bg_color(scr, lv_color_hex(0x27313a), 0);
+    lv_obj_remove_style_all(band);
+    lv_obj_set_style_bg_color(band, lv_color_hex(0x000040), 0);
+    lv_obj_set_style_bg_opa(band, LV_OPA_COVER, 0);
+    lv_obj_set_pos(band, 0, DISPLAY_HEIGHT - WATERFALL_H);
+    lv_obj_set_size(band, DISPLAY_WIDTH, WATERFALL_H);
+    lv_refr_now(disp);
+
+    stage_t *s = stage_begin(name, frames * (full ? DISPLAY_WIDTH * DISPLAY_HEIGHT : DISPLAY_WIDTH * WATERFALL_H), 0);
+
+    for (size_t f = 0; f < frames; f++) {
+        lv_obj_invalidate(full ? scr : band);
+        lv_refr_now(disp);
+    }
+
+    stage_end(s, frames);
+    lv_obj_del(band);
+}
+
+static void flush_cb(lv_disp_drv_t *drv, const lv_area_t *area, lv_color_t *color_p) {
+    lv_disp_flush_ready(drv);
+}
+
+static void lvgl_init() {
+    static lv_disp_draw_buf_t   draw_buf;
+    static lv_disp_drv_t        disp_drv;
+    lv_color_t                  *buf = malloc(DISP_WIDTH * DISP_HEIGHT * sizeof(lv_color_t));
+
+    lv_init();
+    lv_disp_draw_buf_init(&draw_buf, buf, NULL, DISP_WIDTH * DISP_HEIGHT);
+    lv_disp_drv_init(&disp_drv);
+
+    disp_drv.draw_buf = &draw_buf;
+    disp_drv.flush_cb = flush_cb;
+    disp_drv.hor_res = DISP_WIDTH;
+    disp_drv.ver_res = DISP_HEIGHT;
+
+    lv_disp_drv_register(&disp_drv);
+}
+
+static void print_json() {
+    printf("{\n  \"simd\": \"%s\",\n  \"stages\": [\n", simd_backend());
+
+    for (size_t i = 0; i < stages_count; i++) {
+        stage_t *s = &stages[i];
+        double  sec = s->ns / 1e9;
+
+        printf("    { \"name\": \"%s\", \"samples\": %zu, \"seconds\": %.6f, \"ns_per_sample\": %.3f, ",
+            s->name, s->samples, sec, (double) s->ns / s->samples);
+
+        if (s->rate) {
+            printf("\"realtime\": %.2f, ", (double) s->samples / s->rate / sec);
+        }
+
+        printf("\"frames\": %zu, \"frames_per_s\": %.2f, \"allocs\": %zu }%s\n",
+            s->frames, s->frames / sec, s->allocs, i + 1 < stages_count ? "," : "");
+    }
+
+    printf("  ]\n}\n");
+}
+
+int main(int argc, char *argv[]) {
+    const char  *iq_path = NULL;
+    const char  *audio_path = NULL;
+    float       seconds = 10.0f;
+    size_t      rows = 500;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--iq") == 0 && i + 1 < argc) {
+            iq_path = argv[++i];
+        } else if (strcmp(argv[i], "--audio") == 0 && i + 1 < argc) {
+            audio_path = argv[++i];
+        } else if (strcmp(argv[i], "--seconds") == 0 && i + 1 < argc) {
+            seconds = atof(argv[++i]);
+        } else if (strcmp(argv[i], "--rows") == 0 && i + 1 < argc) {
+            rows = atoi(argv[++i]);
+        } else {
+            fprintf(stderr, "Usage: %s [--iq file.sigmf-data] [--audio file.raw] [--seconds N] [--rows N]\n", argv[0]);
+            return 1;
+        }
+    }
+
+    stubs_init();
+    lvgl_init();
+
+    waterfall_init(lv_scr_act(), 14074000);
+    waterfall_set_height(WATERFALL_H);
+
+    dsp_init(1);
+    cw_init();
+    rtty_init();
+
+    size_t          iq_count;
+    float complex   *iq = iq_path ? load_iq(iq_path, &iq_count) : synth_iq(seconds, &iq_count);
+
+    bench_dsp(iq, iq_count);
+
+    bench_spectrum_fft("spectrum_fft_800", 800, iq, iq_count);
+    bench_spectrum_fft("spectrum_fft_1024", 1024, iq, iq_count);
+    bench_spectrum_fft("spectrum_fft_2048", 2048, iq, iq_count);
+    bench_spectrum_fft("spectrum_fft_4096", 4096, iq, iq_count);
+    free(iq);
+
+    size_t  audio_count;
+    int16_t *audio;
+
+    audio = audio_path ? load_audio(audio_path, &audio_count) : synth_cw(seconds, &audio_count);
+    bench_audio("audio_cw", x6100_mode_cw, RTTY_OFF, audio, audio_count);
+    free(audio);
+
+    audio = audio_path ? load_audio(audio_path, &audio_count) : synth_rtty(seconds, &audio_count);
+    bench_audio("audio_rtty", x6100_mode_usb, RTTY_RX, audio, audio_count);
+    free(audio);
+
+    bench_ft8();
+    bench_waterfall(rows);
+
+    bench_lv_waterfall("lv_waterfall_771x325", 325, rows);
+    bench_lv_waterfall("lv_waterfall_771x450", 450, rows);
+
+    bench_spectrum_draw("spectrum_draw_lines_filled", false, true, rows);
+    bench_spectrum_draw("spectrum_draw_raster_filled", true, true, rows);
+    bench_spectrum_draw("spectrum_draw_lines", false, false, rows);
+    bench_spectrum_draw("spectrum_draw_raster", true, false, rows);
+
+    lv_disp_t *disp_before = display_sw_rotate();
+    lv_disp_t *disp_after = display_native();
+
+    bench_display("display_sw_rotate_full", disp_before, true, rows);
+    bench_display("display_native_full", disp_after, true, rows);
+    bench_display("display_sw_rotate_waterfall", disp_before, false, rows);
+    bench_display("display_native_waterfall", disp_after, false, rows);
+
+    print_json();
+
+    return 0;
+}
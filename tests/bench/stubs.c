@@ -0,0 +1,168 @@
+/*
+ *  SPDX-License-Identifier: LGPL-2.1-or-later
+ *
+ *  Xiegu X6100 LVGL GUI
+ *
+ *  Copyright (c) 2024 Georgy Dyuldin aka R2RFE
+ */
+
+#include "stubs.h"
+
+#include "params/params.h"
+#include "spectrum.h"
+#include "meter.h"
+#include "radio.h"
+#include "dialog.h"
+#include "dialog_msg_voice.h"
+#include "pannel.h"
+#include "cw_tune_ui.h"
+#include "band_info.h"
+#include "scheduler.h"
+#include "styles.h"
+#include "governor.h"
+
+#include <string.h>
+
+atomic_uint             stub_spectrum_frames = 0;
+atomic_uint             stub_scheduled = 0;
+atomic_uint             stub_audio_blocks = 0;
+atomic_uint             stub_text_chars = 0;
+
+x6100_mode_t            stub_mode = x6100_mode_usb;
+bool                    stub_run_scheduled = false;
+
+/* Same defaults as params.c, only fields used by benchmarked modules */
+params_t params = {
+    .key_tone               = 700,
+
+    .cw_decoder             = true,
+    .cw_tune                = false,
+    .cw_decoder_snr         = 5.0f,
+    .cw_decoder_snr_gist    = 1.0f,
+    .cw_decoder_peak_beta   = 0.10f,
+    .cw_decoder_noise_beta  = 0.80f,
+
+    .rtty_center            = 800,
+    .rtty_shift             = 170,
+    .rtty_rate              = 4545,
+    .rtty_reverse           = false,
+    .rtty_bits              = 5,
+    .rtty_snr               = 3.0f,
+
+    .waterfall_auto_min     = { .x = true },
+    .waterfall_auto_max     = { .x = true },
+    .waterfall_smooth_scroll= { .x = true },
+    .waterfall_center_line  = { .x = true },
+    .waterfall_zoom         = { .x = true },
+};
+
+lv_style_t              waterfall_style;
+
+static uint32_t         palette[256];
+const uint32_t          *wf_palette = palette;
+
+void stubs_init() {
+    lv_style_init(&waterfall_style);
+
+    for (uint16_t i = 0; i < 256; i++) {
+        palette[i] = 0xFF000000 | (i << 16) | (i << 8) | (255 - i);
+    }
+}
+
+/* Params */
+
+void params_lock() {
+}
+
+void params_unlock(bool *dirty) {
+    if (dirty) {
+        *dirty = true;
+    }
+}
+
+int16_t params_band_grid_min_get() {
+    return -121;
+}
+
+int16_t params_band_grid_max_get() {
+    return -73;
+}
+
+float params_band_smeter_offset_get() {
+    return 0.0f;
+}
+
+int32_t params_lo_offset_get() {
+    return 0;
+}
+
+/* Radio */
+
+x6100_mode_t radio_current_mode() {
+    return stub_mode;
+}
+
+void radio_filter_get(int32_t *from_freq, int32_t *to_freq) {
+    *from_freq = 50;
+    *to_freq = 2950;
+}
+
+/* Governor, DSP time is already in stage results */
+
+uint64_t governor_time_us() {
+    return 0;
+}
+
+void governor_add(governor_stage_t stage, uint64_t begin_us) {
+}
+
+/* UI */
+
+void scheduler_put(scheduler_fn_t fn, void *arg, size_t arg_size) {
+    atomic_fetch_add(&stub_scheduled, 1);
+
+    if (stub_run_scheduled) {
+        fn(arg);
+    }
+}
+
+void spectrum_data(const float *data_buf, const float *peak_buf, const float *min_buf, uint16_t size, bool tx) {
+    atomic_fetch_add(&stub_spectrum_frames, 1);
+}
+
+void spectrum_update_max(float db) {
+}
+
+void spectrum_update_min(float db) {
+}
+
+void meter_update(float db, float beta) {
+}
+
+void meter_update_noise(float db) {
+}
+
+lv_obj_t * band_info_init(lv_obj_t *parent) {
+    return NULL;
+}
+
+void pannel_visible() {
+}
+
+void pannel_add_text(const char * text) {
+    atomic_fetch_add(&stub_text_chars, strlen(text));
+}
+
+void cw_tune_set_freq(float hz) {
+}
+
+void dialog_audio_samples(unsigned int n, float complex *samples) {
+    atomic_fetch_add(&stub_audio_blocks, 1);
+}
+
+msg_voice_state_t dialog_msg_voice_get_state() {
+    return MSG_VOICE_OFF;
+}
+
+void dialog_msg_voice_put_audio_samples(size_t nsamples, int16_t *samples) {
+}
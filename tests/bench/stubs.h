@@ -0,0 +1,31 @@
+/*
+ *  SPDX-License-Identifier: LGPL-2.1-or-later
+ *
+ *  Xiegu X6100 LVGL GUI
+ *
+ *  Copyright (c) 2024 Georgy Dyuldin aka R2RFE
+ */
+
+#pragma once
+
+#include <stdatomic.h>
+#include <stdbool.h>
+
+#include <aether_radio/x6100_control/control.h>
+
+/**
+ * Replacement of UI, params and radio modules for host benchmark.
+ * Counters are updated from DSP thread, so they are atomic
+ */
+
+extern atomic_uint      stub_spectrum_frames;
+extern atomic_uint      stub_scheduled;
+extern atomic_uint      stub_audio_blocks;
+extern atomic_uint      stub_text_chars;
+
+extern x6100_mode_t     stub_mode;
+
+/* Run functions passed to scheduler_put() immediately, otherwise only count them */
+extern bool             stub_run_scheduled;
+
+void stubs_init();
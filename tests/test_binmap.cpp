@@ -0,0 +1,81 @@
+extern "C" {
+    #include "../src/dsp/binmap.h"
+}
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+
+#include <vector>
+
+using Catch::Matchers::WithinAbs;
+
+TEST_CASE("Same size is a copy", "[binmap]") {
+    binmap_t            m = binmap_create(16, 16);
+    std::vector<float>  x(16), y(16);
+
+    for (int i = 0; i < 16; i++) {
+        x[i] = i * 2.0f;
+    }
+
+    binmap_execute(m, x.data(), y.data(), BINMAP_MAX);
+
+    for (int i = 0; i < 16; i++) {
+        REQUIRE_THAT(y[i], WithinAbs(x[i], 1e-6f));
+    }
+
+    binmap_destroy(m);
+}
+
+TEST_CASE("Reduction keeps peaks and center", "[binmap]") {
+    binmap_t            m = binmap_create(1024, 800);
+    std::vector<float>  x(1024, -120.0f), y(800);
+
+    /* Any single bin peak survives max reduction */
+    for (int peak = 0; peak < 1024; peak += 7) {
+        x[peak] = -50.0f;
+        binmap_execute(m, x.data(), y.data(), BINMAP_MAX);
+
+        int found = 0;
+
+        for (int i = 0; i < 800; i++) {
+            if (y[i] == -50.0f) {
+                found++;
+            }
+        }
+        REQUIRE(found >= 1);
+        x[peak] = -120.0f;
+    }
+
+    /* DC bin maps to center */
+    x[512] = -40.0f;
+    binmap_execute(m, x.data(), y.data(), BINMAP_MAX);
+    REQUIRE(y[400] == -40.0f);
+
+    binmap_destroy(m);
+}
+
+TEST_CASE("Mean of reduced bins", "[binmap]") {
+    binmap_t            m = binmap_create(8, 4);
+    std::vector<float>  x = { 0, 2, 4, 6, 8, 10, 12, 14 }, y(4);
+
+    binmap_execute(m, x.data(), y.data(), BINMAP_MEAN);
+
+    /* Output bin 2 is centered on source bin 4 and takes bins 3, 4 */
+    REQUIRE_THAT(y[2], WithinAbs(7.0f, 1e-6f));
+
+    binmap_destroy(m);
+}
+
+TEST_CASE("Expansion interpolates", "[binmap]") {
+    binmap_t            m = binmap_create(4, 8);
+    std::vector<float>  x = { 0, 10, 20, 30 }, y(8);
+
+    binmap_execute(m, x.data(), y.data(), BINMAP_MAX);
+
+    REQUIRE_THAT(y[4], WithinAbs(20.0f, 1e-6f));
+    REQUIRE_THAT(y[5], WithinAbs(25.0f, 1e-6f));
+    REQUIRE_THAT(y[0], WithinAbs(0.0f, 1e-6f));
+    REQUIRE_THAT(y[7], WithinAbs(30.0f, 1e-6f));
+
+    binmap_destroy(m);
+}
@@ -0,0 +1,172 @@
+#include <complex>
+
+extern "C" {
+    #include "../src/dsp/halfband.h"
+}
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+
+#include <cmath>
+#include <vector>
+
+using Catch::Matchers::WithinAbs;
+
+typedef std::complex<float> cf;
+
+static std::vector<cf> make_tone(float freq, size_t n) {
+    std::vector<cf> x(n);
+
+    for (size_t i = 0; i < n; i++) {
+        x[i] = std::polar(1.0f, (float) (2.0 * M_PI * freq * i));
+    }
+    return x;
+}
+
+/* Power of tone at freq (relative to rate), skipping filter transient */
+static float tone_db(const std::vector<cf> &y, float freq, size_t skip) {
+    std::complex<double> acc = 0;
+
+    for (size_t i = skip; i < y.size(); i++) {
+        acc += std::complex<double>(y[i]) * std::polar(1.0, -2.0 * M_PI * freq * i);
+    }
+    acc /= (double) (y.size() - skip);
+
+    return 20.0f * log10f(std::abs(acc) + 1e-20);
+}
+
+/* Chain of decimators with buffer per stage, like spectrum zoom levels in dsp.c */
+struct chain {
+    std::vector<halfband_t>         hb;
+    std::vector<std::vector<cf>>    buf;
+
+    chain(uint8_t stages, size_t n) {
+        for (uint8_t i = 0; i < stages; i++) {
+            n /= 2;
+            hb.push_back(halfband_create(70.0f));
+            buf.emplace_back(n);
+        }
+    }
+
+    ~chain() {
+        for (auto q : hb) {
+            halfband_destroy(q);
+        }
+    }
+
+    const std::vector<cf> & execute(const cf *x, size_t n) {
+        for (size_t i = 0; i < hb.size(); i++) {
+            halfband_execute(hb[i], x, n, buf[i].data());
+            x = buf[i].data();
+            n /= 2;
+        }
+        return buf.back();
+    }
+};
+
+static std::vector<cf> decimate(uint8_t stages, const std::vector<cf> &x) {
+    chain c(stages, x.size());
+
+    return c.execute(x.data(), x.size());
+}
+
+/* Reference: single Kaiser FIR with 2 * M * 16 + 1 taps, like firdecim_crcf_create_kaiser(M, 16, 40) */
+struct kaiser_decim {
+    size_t              m;
+    std::vector<float>  h;
+    std::vector<cf>     buf;
+    size_t              pos = 0;
+
+    kaiser_decim(size_t m) : m(m), h(2 * m * 16 + 1), buf(2 * (2 * m * 16 + 1)) {
+        float fc = 0.5f / m;
+
+        for (size_t i = 0; i < h.size(); i++) {
+            float t = i - (h.size() - 1) / 2.0f;
+            h[i] = (t == 0.0f) ? 2.0f * fc : sinf(2.0f * M_PI * fc * t) / (M_PI * t);
+        }
+    }
+
+    void execute(const cf *x, size_t n, cf *y) {
+        size_t len = h.size();
+
+        for (size_t i = 0; i < n; i++) {
+            buf[pos] = buf[pos + len] = x[i];
+            pos = (pos + 1) % len;
+
+            if ((i + 1) % m == 0) {
+                cf acc = 0;
+
+                for (size_t k = 0; k < len; k++) {
+                    acc += buf[pos + k] * h[k];
+                }
+                y[i / m] = acc;
+            }
+        }
+    }
+};
+
+TEST_CASE("Half-band passband gain", "[halfband]") {
+    /* 0.02 of input rate is well inside passband of all stages */
+    for (uint8_t stages = 1; stages <= 4; stages++) {
+        auto    x = make_tone(0.02f / (1 << stages), 8192);
+        auto    y = decimate(stages, x);
+
+        REQUIRE_THAT(tone_db(y, 0.02f, 64), WithinAbs(0.0f, 0.1f));
+    }
+}
+
+TEST_CASE("Half-band alias rejection", "[halfband]") {
+    const size_t n = 32768;
+
+    SECTION("Single stage") {
+        /* 0.35 of input rate aliases to -0.3 of output rate */
+        auto    y = decimate(1, make_tone(0.35f, n));
+
+        REQUIRE(tone_db(y, -0.3f, 64) < -70.0f);
+    }
+
+    SECTION("Cascade x8") {
+        /* Tones in stopband of each stage alias into output band */
+        float tones[] = {0.4f, 0.17f, 0.085f};
+
+        for (float f : tones) {
+            auto    y = decimate(3, make_tone(f, n));
+            float   alias = f * 8.0f - roundf(f * 8.0f);
+
+            REQUIRE(tone_db(y, alias, 64) < -70.0f);
+        }
+    }
+}
+
+TEST_CASE("Half-band scale", "[halfband]") {
+    auto    x = make_tone(0.01f, 4096);
+    chain   c(2, x.size());
+
+    halfband_set_scale(c.hb[0], 0.5f);
+
+    auto    &y = c.execute(x.data(), x.size());
+
+    REQUIRE_THAT(tone_db(y, 0.04f, 64), WithinAbs(-6.02f, 0.1f));
+}
+
+TEST_CASE("Half-band vs Kaiser decimator", "[.][bench]") {
+    const size_t    n = 512;
+    auto            x = make_tone(0.01f, n);
+    std::vector<cf> y(n);
+
+    for (uint8_t stages = 1; stages <= 4; stages++) {
+        size_t          factor = 1 << stages;
+        chain           c(stages, n);
+        kaiser_decim    k(factor);
+
+        BENCHMARK("half-band x" + std::to_string(factor)) {
+            return c.execute(x.data(), n)[0];
+        };
+
+        BENCHMARK("kaiser x" + std::to_string(factor)) {
+            k.execute(x.data(), n, y.data());
+            return y[0];
+        };
+    }
+}
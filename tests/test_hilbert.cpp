@@ -0,0 +1,72 @@
+#include <complex>
+
+extern "C" {
+    #include "../src/dsp/hilbert.h"
+}
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+
+#include <cmath>
+#include <vector>
+
+using Catch::Matchers::WithinAbs;
+
+static std::vector<float> tone(float freq, size_t n) {
+    std::vector<float> x(n);
+
+    for (size_t i = 0; i < n; i++) {
+        x[i] = cosf(2.0f * M_PI * freq * i);
+    }
+    return x;
+}
+
+static void check_tone(float freq, float tolerance) {
+    hilbert_t                   q = hilbert_create(7, 60.0f);
+    size_t                      n = 4000;
+    size_t                      delay = hilbert_get_delay(q);
+    std::vector<float>          x = tone(freq, n);
+    std::vector<dsp_complex_t>  y(n);
+
+    hilbert_execute(q, x.data(), n, y.data());
+
+    for (size_t i = 100; i < n; i++) {
+        dsp_complex_t expected = std::polar(1.0f, (float) (2.0 * M_PI * freq * (double) (i - delay)));
+
+        REQUIRE_THAT(y[i].real(), WithinAbs(expected.real(), 1e-5f));
+        REQUIRE_THAT(y[i].imag(), WithinAbs(expected.imag(), tolerance));
+    }
+
+    hilbert_destroy(q);
+}
+
+TEST_CASE("Tone in passband becomes positive frequency", "[hilbert]") {
+    check_tone(0.1f, 0.01f);
+    check_tone(0.25f, 0.01f);
+    check_tone(0.4f, 0.01f);
+}
+
+TEST_CASE("Block size does not change output", "[hilbert]") {
+    hilbert_t                   a = hilbert_create(7, 60.0f);
+    hilbert_t                   b = hilbert_create(7, 60.0f);
+    size_t                      n = 3000;
+    std::vector<float>          x = tone(0.03f, n);
+    std::vector<dsp_complex_t>  ya(n);
+    std::vector<dsp_complex_t>  yb(n);
+
+    hilbert_execute(a, x.data(), n, ya.data());
+
+    for (size_t i = 0, part = 1; i < n; i += part, part = part * 3 % 517 + 1) {
+        if (i + part > n) {
+            part = n - i;
+        }
+        hilbert_execute(b, &x[i], part, &yb[i]);
+    }
+
+    for (size_t i = 0; i < n; i++) {
+        REQUIRE(ya[i] == yb[i]);
+    }
+
+    hilbert_destroy(a);
+    hilbert_destroy(b);
+}
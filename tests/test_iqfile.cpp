@@ -0,0 +1,112 @@
+#include <complex>
+
+extern "C" {
+    #include "../src/dsp/iqfile.h"
+}
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <unistd.h>
+#include <vector>
+
+typedef std::complex<float> cf;
+
+static std::string temp_path() {
+    return "/tmp/test_iqfile_" + std::to_string(getpid());
+}
+
+static std::string read_all(const std::string &path) {
+    std::ifstream       in(path);
+    std::stringstream   ss;
+
+    ss << in.rdbuf();
+    return ss.str();
+}
+
+TEST_CASE("IQ file round trip", "[iqfile]") {
+    std::string     path = temp_path();
+    iqfile_meta_t   meta = { .sample_rate = 100000, .frequency = 14074000, .description = "test \"quoted\"" };
+    iqfile_t        f = iqfile_create(path.c_str(), &meta);
+
+    REQUIRE(f != NULL);
+
+    std::vector<cf> samples(512);
+
+    for (uint16_t n = 0; n < 3; n++) {
+        for (size_t i = 0; i < samples.size(); i++) {
+            samples[i] = cf(i + n, -(float) i);
+        }
+
+        iqfile_packet_t packet = { .time_us = 1000u * n, .flags = (uint16_t) (n == 1 ? IQFILE_FLAG_TX : 0), .count = (uint16_t) (512 - n) };
+
+        REQUIRE(iqfile_write(f, &packet, samples.data()));
+    }
+    iqfile_close(f);
+
+    std::string meta_str = read_all(path + IQFILE_META_EXT);
+
+    REQUIRE(meta_str.find("\"core:datatype\": \"cf32_le\"") != std::string::npos);
+    REQUIRE(meta_str.find("\"core:sample_rate\": 100000") != std::string::npos);
+    REQUIRE(meta_str.find("\"core:frequency\": 14074000") != std::string::npos);
+    REQUIRE(meta_str.find("\"x6100:packets\": 3") != std::string::npos);
+    REQUIRE(meta_str.find("test \\\"quoted\\\"") != std::string::npos);
+
+    /* TX packet is annotation */
+    REQUIRE(meta_str.find("\"core:sample_start\": 512,") != std::string::npos);
+    REQUIRE(meta_str.find("\"core:sample_count\": 511,") != std::string::npos);
+    REQUIRE(meta_str.find("\"core:label\": \"TX\"") != std::string::npos);
+
+    std::string data_path = path + IQFILE_DATA_EXT;
+
+    /* Data is plain cf32 samples */
+    std::string data_str = read_all(data_path);
+
+    REQUIRE(data_str.size() == (512 + 511 + 510) * sizeof(cf));
+
+    cf first;
+
+    memcpy(&first, data_str.data() + 513 * sizeof(cf), sizeof(cf));
+    REQUIRE(first == cf(2.0f, -1.0f));
+
+    f = iqfile_open(data_path.c_str());
+    REQUIRE(f != NULL);
+
+    for (uint16_t n = 0; n < 3; n++) {
+        iqfile_packet_t packet;
+
+        REQUIRE(iqfile_read(f, &packet, samples.data(), samples.size()));
+        REQUIRE(packet.time_us == 1000u * n);
+        REQUIRE(packet.flags == (n == 1 ? IQFILE_FLAG_TX : 0));
+        REQUIRE(packet.count == 512 - n);
+        REQUIRE(samples[10] == cf(10 + n, -10.0f));
+        REQUIRE(samples[packet.count - 1] == cf(packet.count - 1 + n, -(float) (packet.count - 1)));
+    }
+
+    iqfile_packet_t packet;
+
+    REQUIRE_FALSE(iqfile_read(f, &packet, samples.data(), samples.size()));
+    REQUIRE(iqfile_packets(f) == 3);
+    iqfile_close(f);
+
+    /* Packet larger than buffer is rejected */
+    f = iqfile_open(data_path.c_str());
+    REQUIRE_FALSE(iqfile_read(f, &packet, samples.data(), 256));
+    iqfile_close(f);
+
+    unlink(data_path.c_str());
+    unlink((path + IQFILE_META_EXT).c_str());
+    unlink((path + IQFILE_INDEX_EXT).c_str());
+}
+
+TEST_CASE("IQ file open missing", "[iqfile]") {
+    REQUIRE(iqfile_open("/nonexistent/file.sigmf-data") == NULL);
+
+    iqfile_meta_t meta = { .sample_rate = 100000, .frequency = 0, .description = NULL };
+
+    REQUIRE(iqfile_create("/nonexistent/file", &meta) == NULL);
+}
@@ -0,0 +1,75 @@
+extern "C" {
+    #include "../src/dsp/palmap.h"
+}
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <cmath>
+#include <cstdlib>
+#include <vector>
+
+static int reference(float x, float min, float max) {
+    float v = (x - min) * 255.0f / (max - min);
+
+    return v < 0.0f ? 0 : (v > 255.0f ? 255 : (int) v);
+}
+
+TEST_CASE("Index follows linear normalization", "[palmap]") {
+    palmap_t                m = palmap_create(-120.0f, -60.0f);
+    std::vector<float>      x;
+    std::vector<uint8_t>    y;
+
+    for (float db = -140.0f; db < -40.0f; db += 0.13f) {
+        x.push_back(db);
+    }
+    y.resize(x.size());
+
+    palmap_execute_index(m, x.data(), x.size(), y.data(), false);
+
+    for (size_t i = 0; i < x.size(); i++) {
+        /* Half of quantization step is 0.125 dB, about 0.53 of index */
+        REQUIRE(std::abs(y[i] - reference(x[i], -120.0f, -60.0f)) <= 1);
+    }
+
+    palmap_destroy(m);
+}
+
+TEST_CASE("Reverse and color output", "[palmap]") {
+    palmap_t                m = palmap_create(-100.0f, 0.0f);
+    std::vector<uint32_t>   palette(256);
+    std::vector<float>      x = { -200.0f, -100.0f, -50.0f, 0.0f, 10.0f };
+    std::vector<uint8_t>    idx(x.size());
+    std::vector<uint32_t>   color(x.size());
+
+    for (int i = 0; i < 256; i++) {
+        palette[i] = 0xFF000000 | (i << 8);
+    }
+    palmap_set_palette(m, palette.data());
+
+    palmap_execute_index(m, x.data(), x.size(), idx.data(), true);
+    palmap_execute_color(m, x.data(), x.size(), color.data());
+
+    REQUIRE(idx[4] == 0);
+    REQUIRE(idx[3] == 0);
+    REQUIRE(idx[2] == 127);
+    REQUIRE(idx[1] == 255);
+    REQUIRE(idx[0] == 255);
+
+    for (size_t i = 0; i < x.size(); i++) {
+        REQUIRE(color[i] == palette[idx[x.size() - 1 - i]]);
+    }
+
+    palmap_destroy(m);
+}
+
+TEST_CASE("Tables are rebuilt only on step change", "[palmap]") {
+    palmap_t m = palmap_create(-100.0f, -50.0f);
+
+    REQUIRE_FALSE(palmap_set_range(m, -100.1f, -50.0f));
+    REQUIRE_FALSE(palmap_set_range(m, -100.2f, -49.9f));
+    REQUIRE(palmap_set_range(m, -100.3f, -50.0f));
+    REQUIRE_FALSE(palmap_set_range(m, -100.2f, -50.0f));
+    REQUIRE(palmap_set_range(m, -100.3f, -49.0f));
+
+    palmap_destroy(m);
+}
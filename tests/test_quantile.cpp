@@ -0,0 +1,116 @@
+extern "C" {
+    #include "../src/dsp/quantile.h"
+}
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+using Catch::Matchers::WithinAbs;
+
+static std::vector<float> make_psd(size_t n) {
+    std::mt19937                    gen(42);
+    std::normal_distribution<float> noise(-110.0f, 4.0f);
+    std::vector<float>              data(n);
+
+    for (auto &x : data) {
+        x = noise(gen);
+    }
+    /* Some strong signals */
+    for (size_t i = 0; i < n; i += 97) {
+        data[i] = -40.0f - (i % 20);
+    }
+    return data;
+}
+
+static int compare_fft(const void *p1, const void *p2) {
+    float *i1 = (float *) p1;
+    float *i2 = (float *) p2;
+
+    return (*i1 < *i2) ? -1 : 1;
+}
+
+TEST_CASE("Quantile matches sorted data", "[quantile]") {
+    auto data = make_psd(1024);
+    auto sorted = data;
+    std::sort(sorted.begin(), sorted.end());
+
+    quantile_t q = quantile_create(-157.0f, 0.0f, 0.25f);
+    quantile_put(q, data.data(), data.size());
+
+    REQUIRE(quantile_count(q) == 1024);
+    REQUIRE_THAT(quantile_get_nth(q, 15), WithinAbs(sorted[15], 0.25f));
+    REQUIRE_THAT(quantile_get_nth(q, 1024 - 11), WithinAbs(sorted[1024 - 11], 0.25f));
+    REQUIRE_THAT(quantile_get(q, 0.5f), WithinAbs(sorted[512], 0.25f));
+
+    quantile_destroy(q);
+}
+
+TEST_CASE("Quantile does not modify input", "[quantile]") {
+    auto data = make_psd(1024);
+    auto copy = data;
+
+    quantile_t q = quantile_create(-157.0f, 0.0f, 0.25f);
+    quantile_put(q, data.data(), data.size());
+    quantile_get_nth(q, 15);
+
+    REQUIRE(data == copy);
+
+    quantile_destroy(q);
+}
+
+TEST_CASE("Quantile clamps out of range values", "[quantile]") {
+    float data[] = {-500.0f, 10.0f, -50.0f};
+
+    quantile_t q = quantile_create(-100.0f, 0.0f, 1.0f);
+    quantile_put(q, data, 3);
+
+    REQUIRE_THAT(quantile_get(q, 0.0f), WithinAbs(-99.5f, 1e-5));
+    REQUIRE_THAT(quantile_get(q, 0.5f), WithinAbs(-49.5f, 1e-5));
+    REQUIRE_THAT(quantile_get(q, 1.0f), WithinAbs(-0.5f, 1e-5));
+
+    quantile_reset(q);
+    REQUIRE(quantile_count(q) == 0);
+
+    quantile_destroy(q);
+}
+
+TEST_CASE("Quantile of infinite and NaN values", "[quantile]") {
+    quantile_t  q = quantile_create(-100.0f, 0.0f, 1.0f);
+    float       data[] = { -INFINITY, NAN, INFINITY, -50.0f };
+
+    quantile_put(q, data, 4);
+
+    REQUIRE(quantile_count(q) == 4);
+    REQUIRE_THAT(quantile_get_nth(q, 0), WithinAbs(-99.5f, 1e-5));
+    REQUIRE_THAT(quantile_get_nth(q, 1), WithinAbs(-99.5f, 1e-5));
+    REQUIRE_THAT(quantile_get_nth(q, 2), WithinAbs(-49.5f, 1e-5));
+    REQUIRE_THAT(quantile_get_nth(q, 3), WithinAbs(-0.5f, 1e-5));
+
+    quantile_destroy(q);
+}
+
+TEST_CASE("Quantile vs qsort", "[.][bench]") {
+    auto        data = make_psd(1024);
+    quantile_t  q = quantile_create(-157.0f, 0.0f, 0.25f);
+
+    BENCHMARK("qsort 1024") {
+        auto copy = data;
+        qsort(copy.data(), copy.size(), sizeof(float), compare_fft);
+        return copy[15] + copy[1024 - 11];
+    };
+
+    BENCHMARK("quantile 1024") {
+        quantile_reset(q);
+        quantile_put(q, data.data(), data.size());
+        return quantile_get_nth(q, 15) + quantile_get_nth(q, 1024 - 11);
+    };
+
+    quantile_destroy(q);
+}
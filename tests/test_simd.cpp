@@ -0,0 +1,297 @@
+extern "C" {
+    #include "../src/simd/simd.h"
+}
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
+
+#include <cmath>
+#include <complex>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <vector>
+
+/* Odd size to cover vector tail */
+#define N 1027
+
+/* Reference loops, as they were in the GUI before vectorization */
+
+static void ref_gain(const int16_t *buf, size_t samples, float scale, int16_t *out) {
+    for (size_t i = 0; i < samples; i++) {
+        int32_t x = buf[i] * scale;
+
+        if (x > 32767) {
+            x = 32767;
+        }
+        if (x < -32767) {
+            x = -32767;
+        }
+        out[i] = x;
+    }
+}
+
+static void ref_gain_ramp(const int16_t *buf, size_t samples, float scale1, float scale2, int16_t *out) {
+    for (size_t i = 0; i < samples; i++) {
+        float   scale = scale1 + i * (scale2 - scale1) / samples;
+        int32_t x = buf[i] * scale;
+
+        if (x > 32767) {
+            x = 32767;
+        }
+        if (x < -32767) {
+            x = -32767;
+        }
+        out[i] = x;
+    }
+}
+
+static void ref_normalize(const float *data_buf, size_t size, float min, float max, uint8_t *out) {
+    for (size_t x = 0; x < size; x++) {
+        float v = (data_buf[x] - min) / (max - min);
+
+        if (v < 0.0f) {
+            v = 0.0f;
+        } else if (v > 1.0f) {
+            v = 1.0f;
+        }
+        out[size - 1 - x] = v * 255;
+    }
+}
+
+static void ref_power_db(const std::complex<float> *freq_buf, size_t num_bins, size_t osr, size_t sub, uint8_t *out) {
+    for (size_t bin = 0; bin < num_bins; bin++) {
+        std::complex<float> freq = freq_buf[bin * osr + sub];
+        float               db = 10.0f * log10f(std::norm(freq));
+        int                 scaled = (int16_t)(db * 2.0f + 240.0f);
+
+        if (scaled < 0) {
+            scaled = 0;
+        } else if (scaled > 255) {
+            scaled = 255;
+        }
+        out[bin] = scaled;
+    }
+}
+
+static std::vector<int16_t> make_audio(size_t n) {
+    std::mt19937                            gen(1);
+    std::uniform_int_distribution<int16_t>  dist(-32768, 32767);
+    std::vector<int16_t>                    x(n);
+
+    for (auto &v : x) {
+        v = dist(gen);
+    }
+    return x;
+}
+
+static std::vector<float> make_psd(size_t n) {
+    std::mt19937                            gen(2);
+    std::uniform_real_distribution<float>   dist(-140.0f, -20.0f);
+    std::vector<float>                      x(n);
+
+    for (auto &v : x) {
+        v = dist(gen);
+    }
+    return x;
+}
+
+static std::vector<std::complex<float>> make_spectrum(size_t n) {
+    std::mt19937                            gen(3);
+    std::normal_distribution<float>         dist(0.0f, 1.0f);
+    std::uniform_real_distribution<float>   level(-12.0f, 2.0f);
+    std::vector<std::complex<float>>        x(n);
+
+    for (auto &v : x) {
+        float a = powf(10.0f, level(gen));
+
+        v = std::complex<float>(dist(gen) * a, dist(gen) * a);
+    }
+    return x;
+}
+
+template <typename T>
+static int max_diff(const std::vector<T> &a, const std::vector<T> &b) {
+    int res = 0;
+
+    for (size_t i = 0; i < a.size(); i++) {
+        res = std::max(res, std::abs((int) a[i] - (int) b[i]));
+    }
+    return res;
+}
+
+TEST_CASE("SIMD add scalar", "[simd]") {
+    auto                x = make_psd(N);
+    std::vector<float>  y(N);
+
+    simd_add_scalar_f32(x.data(), N, -30.0f, y.data());
+
+    for (size_t i = 0; i < N; i++) {
+        REQUIRE(y[i] == x[i] - 30.0f);
+    }
+
+    simd_add_scalar_f32(x.data(), N, 10.0f, x.data());
+    REQUIRE(x[N - 1] == y[N - 1] + 40.0f);
+}
+
+TEST_CASE("SIMD int16 to float", "[simd]") {
+    auto                x = make_audio(N);
+    std::vector<float>  y(N);
+
+    simd_s16_to_f32(x.data(), N, 1.0f / 32768.0f, y.data());
+
+    for (size_t i = 0; i < N; i++) {
+        REQUIRE(y[i] == x[i] / 32768.0f);
+    }
+}
+
+TEST_CASE("SIMD gain", "[simd]") {
+    auto                    x = make_audio(N);
+    std::vector<int16_t>    y(N), ref(N);
+
+    for (float db : {-40.0f, -6.0f, 0.0f, 3.0f, 20.0f}) {
+        float scale = powf(10.0f, db / 20.0f);
+
+        simd_gain_s16(x.data(), N, scale, y.data());
+        ref_gain(x.data(), N, scale, ref.data());
+        REQUIRE(max_diff(y, ref) <= 1);
+    }
+}
+
+TEST_CASE("SIMD gain ramp", "[simd]") {
+    auto                    x = make_audio(N);
+    std::vector<int16_t>    y(N), ref(N);
+
+    simd_gain_ramp_s16(x.data(), N, 0.1f, 4.0f, y.data());
+    ref_gain_ramp(x.data(), N, 0.1f, 4.0f, ref.data());
+    REQUIRE(max_diff(y, ref) <= 1);
+
+    simd_gain_ramp_s16(x.data(), N, 2.0f, 0.0f, y.data());
+    ref_gain_ramp(x.data(), N, 2.0f, 0.0f, ref.data());
+    REQUIRE(max_diff(y, ref) <= 1);
+}
+
+TEST_CASE("SIMD normalize", "[simd]") {
+    auto                    x = make_psd(N);
+    std::vector<uint8_t>    y(N), ref(N);
+
+    simd_normalize_u8(x.data(), N, -120.0f, -40.0f, y.data(), true);
+    ref_normalize(x.data(), N, -120.0f, -40.0f, ref.data());
+    REQUIRE(max_diff(y, ref) <= 1);
+
+    std::vector<uint8_t>    fwd(N);
+
+    simd_normalize_u8(x.data(), N, -120.0f, -40.0f, fwd.data(), false);
+
+    for (size_t i = 0; i < N; i++) {
+        REQUIRE(fwd[i] == y[N - 1 - i]);
+    }
+}
+
+TEST_CASE("SIMD power dB", "[simd]") {
+    const size_t    bins = 515;
+    auto            x = make_spectrum(bins * 3);
+
+    for (size_t osr : {1, 2, 3}) {
+        for (size_t sub = 0; sub < osr; sub++) {
+            std::vector<uint8_t> y(bins), ref(bins);
+
+            simd_power_db_u8((const float *) &x[sub], bins, osr, 2.0f, 240.0f, y.data());
+            ref_power_db(x.data(), bins, osr, sub, ref.data());
+            REQUIRE(max_diff(y, ref) <= 1);
+        }
+    }
+
+    /* Silence is clamped to zero, not undefined */
+    std::vector<std::complex<float>>    zero(16);
+    std::vector<uint8_t>                y(16, 0xFF);
+
+    simd_power_db_u8((const float *) zero.data(), 16, 1, 2.0f, 240.0f, y.data());
+
+    for (auto v : y) {
+        REQUIRE(v == 0);
+    }
+}
+
+TEST_CASE("SIMD rotate 90", "[simd]") {
+    for (auto size : { std::make_pair(1, 1), std::make_pair(4, 4), std::make_pair(37, 21), std::make_pair(800, 35) }) {
+        size_t                  w = size.first;
+        size_t                  h = size.second;
+        size_t                  x_stride = w + 3;
+        size_t                  y_stride = h + 5;
+        std::vector<uint32_t>   x(x_stride * h);
+        std::vector<uint32_t>   y(y_stride * w, 0xDEADBEEF);
+
+        for (size_t i = 0; i < x.size(); i++) {
+            x[i] = i;
+        }
+
+        simd_rotate90_u32(x.data(), x_stride, w, h, y.data(), y_stride);
+
+        for (size_t r = 0; r < h; r++) {
+            for (size_t c = 0; c < w; c++) {
+                REQUIRE(y[(w - 1 - c) * y_stride + r] == x[r * x_stride + c]);
+            }
+        }
+
+        /* Padding is not touched */
+        for (size_t i = 0; i < w; i++) {
+            for (size_t j = h; j < y_stride; j++) {
+                REQUIRE(y[i * y_stride + j] == 0xDEADBEEF);
+            }
+        }
+    }
+}
+
+TEST_CASE("SIMD kernels vs scalar", "[.][bench]") {
+    const size_t            n = 1024;
+    auto                    audio = make_audio(n);
+    auto                    psd = make_psd(n);
+    auto                    spectrum = make_spectrum(n * 2);
+    std::vector<int16_t>    audio_out(n);
+    std::vector<float>      f_out(n);
+    std::vector<uint8_t>    u8_out(n);
+
+    std::string backend = simd_backend();
+
+    BENCHMARK("gain " + backend) {
+        simd_gain_s16(audio.data(), n, 0.5f, audio_out.data());
+        return audio_out[0];
+    };
+    BENCHMARK("gain reference") {
+        ref_gain(audio.data(), n, 0.5f, audio_out.data());
+        return audio_out[0];
+    };
+    BENCHMARK("gain ramp " + backend) {
+        simd_gain_ramp_s16(audio.data(), n, 0.5f, 1.0f, audio_out.data());
+        return audio_out[0];
+    };
+    BENCHMARK("gain ramp reference") {
+        ref_gain_ramp(audio.data(), n, 0.5f, 1.0f, audio_out.data());
+        return audio_out[0];
+    };
+    BENCHMARK("normalize " + backend) {
+        simd_normalize_u8(psd.data(), n, -120.0f, -40.0f, u8_out.data(), true);
+        return u8_out[0];
+    };
+    BENCHMARK("normalize reference") {
+        ref_normalize(psd.data(), n, -120.0f, -40.0f, u8_out.data());
+        return u8_out[0];
+    };
+    BENCHMARK("power dB " + backend) {
+        simd_power_db_u8((const float *) spectrum.data(), n, 2, 2.0f, 240.0f, u8_out.data());
+        return u8_out[0];
+    };
+    BENCHMARK("power dB reference") {
+        ref_power_db(spectrum.data(), n, 2, 0, u8_out.data());
+        return u8_out[0];
+    };
+    BENCHMARK("int16 to float " + backend) {
+        simd_s16_to_f32(audio.data(), n, 1.0f / 32768.0f, f_out.data());
+        return f_out[0];
+    };
+    BENCHMARK("add scalar " + backend) {
+        simd_add_scalar_f32(psd.data(), n, -30.0f, f_out.data());
+        return f_out[0];
+    };
+}
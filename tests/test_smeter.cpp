@@ -0,0 +1,52 @@
+extern "C" {
+    #include "../src/dsp/smeter.h"
+}
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+
+#include <cmath>
+#include <vector>
+
+using Catch::Matchers::WithinAbs;
+
+TEST_CASE("Flat PSD integrates to bandwidth", "[smeter]") {
+    std::vector<float> psd(64, -100.0f);
+
+    REQUIRE_THAT(smeter_channel_power(psd.data(), 10, 10, 1.0f), WithinAbs(-100.0f, 0.01f));
+    REQUIRE_THAT(smeter_channel_power(psd.data(), 0, 9, 1.0f), WithinAbs(-90.0f, 0.01f));
+    REQUIRE_THAT(smeter_channel_power(psd.data(), 0, 29, 1.5f), WithinAbs(-100.0f + smeter_bandwidth_db(30, 1.5f), 0.01f));
+}
+
+TEST_CASE("Carrier reads its peak bin with window correction", "[smeter]") {
+    std::vector<float> psd(64, -160.0f);
+
+    /* Hann window spreads a bin-centered carrier as 1/4, 1, 1/4 in power */
+    psd[31] = -80.0f + 10.0f * log10f(0.25f);
+    psd[32] = -80.0f;
+    psd[33] = -80.0f + 10.0f * log10f(0.25f);
+
+    REQUIRE_THAT(smeter_channel_power(psd.data(), 20, 40, 1.5f), WithinAbs(-80.0f, 0.01f));
+}
+
+TEST_CASE("Attack and decay", "[smeter]") {
+    smeter_t m = smeter_create();
+
+    smeter_set_ballistics(m, 0.0f, 1000.0f);
+
+    REQUIRE(smeter_put(m, -100.0f, 40.0f) == -100.0f);
+    REQUIRE(smeter_put(m, -60.0f, 40.0f) == -60.0f);
+
+    float x = -60.0f;
+
+    for (int i = 0; i < 25; i++) {
+        x = smeter_put(m, -100.0f, 40.0f);
+    }
+
+    REQUIRE_THAT(x, WithinAbs(-100.0f + 40.0f * expf(-1.0f), 0.01f));
+
+    smeter_reset(m);
+    REQUIRE(smeter_put(m, -120.0f, 40.0f) == -120.0f);
+
+    smeter_destroy(m);
+}
@@ -0,0 +1,135 @@
+extern "C" {
+    #include "../src/dsp/specdraw.h"
+}
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <vector>
+
+#define W   16
+#define H   10
+#define BG  0xFF000000u
+#define FG  0xFFFFFFFFu
+
+struct Canvas {
+    std::vector<uint32_t>   pixels;
+    specdraw_canvas_t       c;
+    specdraw_area_t         a;
+
+    Canvas() : pixels(W * H, BG) {
+        c.buf = pixels.data();
+        c.stride = W;
+        c.buf_x = 100;
+        c.buf_y = 200;
+        c.clip_x1 = 100;
+        c.clip_y1 = 200;
+        c.clip_x2 = 100 + W - 1;
+        c.clip_y2 = 200 + H - 1;
+
+        /* Value 0 is just below the buffer, value 10 on the top row */
+        a.x = 100;
+        a.y = 200;
+        a.w = W;
+        a.h = H;
+        a.min = 0.0f;
+        a.max = 10.0f;
+    }
+
+    uint32_t px(int x, int y) const {
+        return pixels[y * W + x];
+    }
+
+    int column(int x) const {
+        int count = 0;
+
+        for (int y = 0; y < H; y++) {
+            if (px(x, y) != BG) count++;
+        }
+        return count;
+    }
+};
+
+TEST_CASE("Filled columns go down to the bottom", "[specdraw]") {
+    Canvas              cv;
+    std::vector<float>  v(W);
+
+    for (int i = 0; i < W; i++) {
+        v[i] = i % 10;
+    }
+
+    specdraw_trace(&cv.c, &cv.a, v.data(), W, SPECDRAW_FILLED, FG, 255);
+
+    for (int x = 0; x < W; x++) {
+        REQUIRE(cv.column(x) == x % 10);
+        REQUIRE((x % 10 == 0 || cv.px(x, H - 1) == FG));
+    }
+}
+
+TEST_CASE("Filled keeps the highest of values in a column", "[specdraw]") {
+    Canvas              cv;
+    std::vector<float>  v(W * 2, 2.0f);
+
+    v[7] = 8.0f;
+
+    specdraw_trace(&cv.c, &cv.a, v.data(), v.size(), SPECDRAW_FILLED, FG, 255);
+
+    REQUIRE(cv.column(2) == 2);
+    REQUIRE(cv.column(3) == 8);
+    REQUIRE(cv.column(4) == 2);
+
+    /* Fewer values than columns */
+
+    Canvas cv2;
+
+    specdraw_trace(&cv2.c, &cv2.a, v.data(), 4, SPECDRAW_FILLED, FG, 255);
+
+    for (int x = 0; x < W; x++) {
+        REQUIRE(cv2.column(x) == 2);
+    }
+}
+
+TEST_CASE("Line is connected without overlap", "[specdraw]") {
+    Canvas              cv;
+    std::vector<float>  v(W, 1.0f);
+
+    v[5] = 9.0f;
+
+    specdraw_trace(&cv.c, &cv.a, v.data(), W, SPECDRAW_LINE, 0xFF808080, 128);
+
+    int total = 0;
+
+    for (int x = 0; x < W; x++) {
+        int n = cv.column(x);
+
+        REQUIRE(n >= 1);
+        total += n;
+    }
+
+    /* Flat parts, then the peak column and the next one with 8 px each */
+    REQUIRE(total == (W - 2) + 8 + 8);
+
+    /* Alpha blend over black */
+    REQUIRE(cv.px(0, H - 1) == 0xFF404040);
+}
+
+TEST_CASE("Clip area is respected", "[specdraw]") {
+    Canvas              cv;
+    std::vector<float>  v(W, 100.0f);
+
+    cv.c.clip_x1 = 104;
+    cv.c.clip_x2 = 107;
+    cv.c.clip_y1 = 203;
+
+    cv.a.x = 90;
+    cv.a.w = W + 20;
+
+    specdraw_trace(&cv.c, &cv.a, v.data(), W, SPECDRAW_FILLED, FG, 255);
+
+    for (int x = 0; x < W; x++) {
+        for (int y = 0; y < H; y++) {
+            bool inside = x >= 4 && x <= 7 && y >= 3;
+
+            REQUIRE((cv.px(x, y) == FG) == inside);
+        }
+    }
+}
@@ -0,0 +1,163 @@
+extern "C" {
+    #include "../src/dsp/trace.h"
+}
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+
+#include <cmath>
+#include <vector>
+
+using Catch::Matchers::WithinAbs;
+
+static float run_step(float fps, float seconds, float tau_ms) {
+    trace_t             t = trace_create(4);
+    std::vector<float>  low(4, -120.0f);
+    std::vector<float>  high(4, -80.0f);
+    float               dt = 1000.0f / fps;
+
+    trace_set_avg(t, TRACE_AVG_DB, tau_ms);
+    trace_put(t, low.data(), dt, false);
+
+    for (int i = 0; i < (int) (seconds * fps + 0.5f); i++) {
+        trace_put(t, high.data(), dt, false);
+    }
+
+    float res = trace_avg(t)[0];
+
+    trace_destroy(t);
+    return res;
+}
+
+TEST_CASE("Average does not depend on frame rate", "[trace]") {
+    float expected = -80.0f - 40.0f * expf(-1000.0f / 200.0f);
+
+    REQUIRE_THAT(run_step(5.0f, 1.0f, 200.0f), WithinAbs(expected, 0.01f));
+    REQUIRE_THAT(run_step(15.0f, 1.0f, 200.0f), WithinAbs(expected, 0.01f));
+    REQUIRE_THAT(run_step(60.0f, 1.0f, 200.0f), WithinAbs(expected, 0.01f));
+}
+
+TEST_CASE("Zero time constant follows input", "[trace]") {
+    REQUIRE_THAT(run_step(15.0f, 0.1f, 0.0f), WithinAbs(-80.0f, 1e-4f));
+}
+
+TEST_CASE("Power averaging is mean of linear power", "[trace]") {
+    trace_t             t = trace_create(1);
+    std::vector<float>  a(1, -100.0f);
+    std::vector<float>  b(1, -80.0f);
+
+    trace_set_avg(t, TRACE_AVG_POWER, 2000.0f);
+
+    for (int i = 0; i < 2000; i++) {
+        trace_put(t, (i & 1) ? b.data() : a.data(), 10.0f, false);
+    }
+
+    float expected = 10.0f * log10f((1e-10f + 1e-8f) / 2.0f);
+
+    REQUIRE_THAT(trace_avg(t)[0], WithinAbs(expected, 0.2f));
+
+    /* Same input in dB domain gives the mean of dB values */
+    trace_set_avg(t, TRACE_AVG_DB, 2000.0f);
+
+    for (int i = 0; i < 2000; i++) {
+        trace_put(t, (i & 1) ? b.data() : a.data(), 10.0f, false);
+    }
+
+    REQUIRE_THAT(trace_avg(t)[0], WithinAbs(-90.0f, 0.2f));
+
+    trace_destroy(t);
+}
+
+TEST_CASE("Max and min hold, then release", "[trace]") {
+    trace_t             t = trace_create(1);
+    std::vector<float>  base(1, -100.0f);
+    std::vector<float>  spike(1, -60.0f);
+    std::vector<float>  dip(1, -130.0f);
+
+    trace_set_avg(t, TRACE_AVG_DB, 0.0f);
+    trace_set_hold(t, 1000.0f, 10.0f);
+
+    trace_put(t, base.data(), 100.0f, true);
+    trace_put(t, spike.data(), 100.0f, true);
+    trace_put(t, dip.data(), 100.0f, true);
+
+    REQUIRE(trace_max(t)[0] == -60.0f);
+    REQUIRE(trace_min(t)[0] == -130.0f);
+
+    /* Hold time, 1 s from the extremum */
+    for (int i = 0; i < 9; i++) {
+        trace_put(t, base.data(), 100.0f, true);
+    }
+
+    REQUIRE(trace_max(t)[0] == -60.0f);
+    REQUIRE(trace_min(t)[0] == -130.0f);
+
+    /* Release 10 dB/s */
+    for (int i = 0; i < 11; i++) {
+        trace_put(t, base.data(), 100.0f, true);
+    }
+
+    REQUIRE_THAT(trace_max(t)[0], WithinAbs(-70.0f, 1.5f));
+    REQUIRE_THAT(trace_min(t)[0], WithinAbs(-120.0f, 1.5f));
+
+    /* Never crosses the average */
+    for (int i = 0; i < 100; i++) {
+        trace_put(t, base.data(), 100.0f, true);
+    }
+
+    REQUIRE(trace_max(t)[0] == -100.0f);
+    REQUIRE(trace_min(t)[0] == -100.0f);
+
+    trace_destroy(t);
+}
+
+TEST_CASE("Hold off keeps extremes", "[trace]") {
+    trace_t             t = trace_create(1);
+    std::vector<float>  base(1, -100.0f);
+    std::vector<float>  spike(1, -60.0f);
+
+    trace_set_hold(t, 0.0f, 100.0f);
+
+    trace_put(t, base.data(), 100.0f, true);
+    trace_put(t, spike.data(), 100.0f, false);
+
+    REQUIRE(trace_max(t)[0] == -100.0f);
+    REQUIRE(trace_avg(t)[0] == -60.0f);
+
+    trace_destroy(t);
+}
+
+TEST_CASE("Shift moves hold traces", "[trace]") {
+    trace_t             t = trace_create(8);
+    std::vector<float>  base(8, -100.0f);
+    std::vector<float>  spike(8, -100.0f);
+
+    spike[2] = -50.0f;
+
+    trace_set_avg(t, TRACE_AVG_DB, 1000.0f);
+    trace_set_hold(t, 5000.0f, 1.0f);
+
+    trace_put(t, base.data(), 100.0f, true);
+    trace_put(t, spike.data(), 100.0f, true);
+
+    float peak = trace_max(t)[2];
+
+    REQUIRE(peak > -100.0f);
+
+    trace_shift(t, 3);
+    REQUIRE(trace_max(t)[5] == peak);
+    REQUIRE(trace_max(t)[0] == trace_avg(t)[0]);
+    REQUIRE(trace_max(t)[2] == trace_avg(t)[2]);
+
+    trace_shift(t, -4);
+    REQUIRE(trace_max(t)[1] == peak);
+    REQUIRE(trace_max(t)[7] == trace_avg(t)[7]);
+
+    trace_shift(t, 100);
+
+    for (int i = 0; i < 8; i++) {
+        REQUIRE(trace_max(t)[i] == trace_avg(t)[i]);
+    }
+
+    trace_destroy(t);
+}
@@ -0,0 +1,119 @@
+extern "C" {
+    #include "../src/dsp/wfhist.h"
+}
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <cstdlib>
+#include <vector>
+
+static std::vector<uint8_t> make_row(uint32_t seed, uint16_t width) {
+    std::vector<uint8_t> row(width);
+
+    srand(seed);
+
+    for (uint16_t i = 0; i < width; i++) {
+        /* Floor clamped to zero, noise and a few carriers */
+        int v = rand() % 64 - 32;
+
+        row[i] = v < 0 ? 0 : v;
+
+        if ((i + seed) % 97 < 3) {
+            row[i] = 255;
+        }
+    }
+    return row;
+}
+
+TEST_CASE("Rows are restored exactly", "[wfhist]") {
+    wfhist_t                h = wfhist_create(1 << 20, 1000, 800);
+    std::vector<uint8_t>    out(800);
+
+    for (uint32_t i = 0; i < 100; i++) {
+        std::vector<uint8_t> row = make_row(i, 800);
+
+        REQUIRE(wfhist_put(h, row.data(), 14074000 + i, 100000, i * 40) == i);
+    }
+
+    /* Noise is not packed, but never grows much */
+    REQUIRE(wfhist_used(h) <= 100 * (800 + 800 / 128 + 1));
+
+    for (uint32_t i = 0; i < 100; i++) {
+        int64_t     freq;
+        int32_t     span;
+        uint64_t    time;
+
+        REQUIRE(wfhist_get(h, i, out.data(), &freq, &span, &time));
+        REQUIRE(out == make_row(i, 800));
+        REQUIRE(freq == 14074000 + i);
+        REQUIRE(span == 100000);
+        REQUIRE(time == i * 40);
+    }
+
+    REQUIRE_FALSE(wfhist_get(h, 100, out.data(), NULL, NULL, NULL));
+
+    wfhist_destroy(h);
+}
+
+TEST_CASE("Clamped floor is packed", "[wfhist]") {
+    wfhist_t                h = wfhist_create(1 << 20, 1000, 800);
+    std::vector<uint8_t>    row(800, 0);
+    std::vector<uint8_t>    out(800);
+
+    for (uint16_t i = 100; i < 110; i++) {
+        row[i] = 200 + i - 100;
+    }
+    for (uint16_t i = 500; i < 530; i++) {
+        row[i] = 255;
+    }
+
+    wfhist_put(h, row.data(), 0, 100000, 0);
+
+    REQUIRE(wfhist_used(h) < 40);
+    REQUIRE(wfhist_get(h, 0, out.data(), NULL, NULL, NULL));
+    REQUIRE(out == row);
+
+    wfhist_destroy(h);
+}
+
+TEST_CASE("Oldest rows are dropped when arena is full", "[wfhist]") {
+    wfhist_t                h = wfhist_create(64 * 1024, 10000, 800);
+    std::vector<uint8_t>    out(800);
+
+    for (uint32_t i = 0; i < 2000; i++) {
+        std::vector<uint8_t> row = make_row(i, 800);
+
+        wfhist_put(h, row.data(), i, 100000, i * 40);
+        REQUIRE(wfhist_used(h) <= 64 * 1024);
+    }
+
+    uint32_t first = wfhist_first(h);
+
+    REQUIRE(first > 0);
+    REQUIRE(wfhist_next(h) == 2000);
+    REQUIRE_FALSE(wfhist_get(h, first - 1, out.data(), NULL, NULL, NULL));
+
+    for (uint32_t i = first; i < 2000; i++) {
+        REQUIRE(wfhist_get(h, i, out.data(), NULL, NULL, NULL));
+        REQUIRE(out == make_row(i, 800));
+    }
+
+    wfhist_destroy(h);
+}
+
+TEST_CASE("Row count limit and search by time", "[wfhist]") {
+    wfhist_t                h = wfhist_create(1 << 20, 50, 16);
+    std::vector<uint8_t>    row(16, 7);
+
+    for (uint32_t i = 0; i < 120; i++) {
+        wfhist_put(h, row.data(), 0, 0, 1000 + i * 10);
+    }
+
+    REQUIRE(wfhist_first(h) == 70);
+    REQUIRE(wfhist_find(h, 1000 + 100 * 10) == 100);
+    REQUIRE(wfhist_find(h, 1000 + 100 * 10 + 5) == 100);
+    REQUIRE(wfhist_find(h, 0) == 70);
+    REQUIRE(wfhist_find(h, 1000000) == 119);
+
+    wfhist_destroy(h);
+}
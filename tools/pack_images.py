@@ -0,0 +1,81 @@
+#!/usr/bin/env python3
+#
+#  SPDX-License-Identifier: LGPL-2.1-or-later
+#
+#  Xiegu X6100 LVGL GUI
+#
+#  Copyright (c) 2024 Georgy Dyuldin aka R2RFE
+#
+#  Pack LVGL .bin images into one archive, which is mapped by src/assets.c
+#
+#  Archive (little endian):
+#      header  magic "X6AP", version, count, reserved           4 x u32
+#      index   name[32], lv_img_header_t, offset, size, reserved  per image
+#      data    pixels of each image, aligned to ALIGN
+
+import argparse
+import os
+import struct
+import sys
+
+MAGIC = 0x50413658
+VERSION = 1
+NAME_LEN = 32
+ALIGN = 64
+
+HEADER = struct.Struct("<4I")
+ENTRY = struct.Struct("<%dsIIII" % NAME_LEN)
+
+
+def align(x):
+    return (x + ALIGN - 1) // ALIGN * ALIGN
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Pack LVGL .bin images into one archive")
+    parser.add_argument("dir", help="directory with .bin images")
+    parser.add_argument("output", help="archive file")
+    args = parser.parse_args()
+
+    images = []
+
+    for file in sorted(os.listdir(args.dir)):
+        name, ext = os.path.splitext(file)
+
+        if ext != ".bin":
+            continue
+
+        if len(name) >= NAME_LEN:
+            sys.exit("Too long name %s" % file)
+
+        with open(os.path.join(args.dir, file), "rb") as f:
+            raw = f.read()
+
+        if len(raw) <= 4:
+            sys.exit("Wrong image %s" % file)
+
+        header, = struct.unpack_from("<I", raw)
+        images.append((name, header, raw[4:]))
+
+    offset = align(HEADER.size + ENTRY.size * len(images))
+    index = []
+
+    for name, header, data in images:
+        index.append(ENTRY.pack(name.encode(), header, offset, len(data), 0))
+        offset = align(offset + len(data))
+
+    with open(args.output, "wb") as f:
+        f.write(HEADER.pack(MAGIC, VERSION, len(images), 0))
+
+        for entry in index:
+            f.write(entry)
+
+        for _, _, data in images:
+            f.seek(align(f.tell()))
+            f.write(data)
+
+    print("%d images, %d bytes" % (len(images), os.path.getsize(args.output)))
+
+
+if __name__ == "__main__":
+    main()